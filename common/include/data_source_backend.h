@@ -0,0 +1,45 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <soci/odbc/soci-odbc.h>
+#include <soci/sqlite3/soci-sqlite3.h>
+#include <string>
+
+namespace rtd {
+namespace datasource {
+
+/**
+ * 数据源使用的SOCI后端
+ * data_source.json中每个数据源可用"backend"选择后端，缺省为odbc。
+ * sqlite3用于在单机上联调和压测，不依赖外部数据库，DSN文件内容为SOCI的SQLite连接串，
+ * 如 "db=/tmp/rtd_local.db timeout=5"，建表和造数脚本见common/sql/sqlite
+ */
+constexpr const char *kDefaultBackend = "odbc";
+
+// 按名称取得SOCI后端，不支持的名称返回空
+inline const soci::backend_factory *backendFactory(const std::string &backend)
+{
+    if (backend == "odbc") {
+        return &soci::odbc;
+    }
+    if (backend == "sqlite3") {
+        return &soci::sqlite3;
+    }
+    return nullptr;
+}
+
+/**
+ * 查询在指定后端上执行的SQL
+ * api.json中的查询可用"backend_sql"按后端名给出方言不同的写法，没有对应项时使用"sql"
+ */
+inline std::string querySql(const nlohmann::json &query, const std::string &backend)
+{
+    auto overrides = query.find("backend_sql");
+    if (overrides != query.end() && overrides->contains(backend)) {
+        return overrides->at(backend).get<std::string>();
+    }
+    return query.at("sql").get<std::string>();
+}
+
+}    // namespace datasource
+}    // namespace rtd
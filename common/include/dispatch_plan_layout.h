@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace rtd {
+namespace dispatch {
+
+/**
+ * 内存派工计划的二进制布局
+ * 由调度引擎(rtd_schedule)写入tmpfs文件，服务端(rtd_server)以只读方式mmap后直接查询。
+ * 写入方总是生成完整的新快照并通过rename原子替换，然后把旧快照的superseded置1，
+ * 读取方只需检查该标志即可发现新计划，正常查询路径没有任何系统调用。
+ *
+ * 文件结构: PlanHeader | PlanEquipment[equipmentCount] | PlanEntry[entryCount]
+ * PlanEquipment按eqpId升序排列，可直接二分查找。
+ */
+
+constexpr uint32_t    kPlanMagic       = 0x50445452;    // "RTDP"
+constexpr uint32_t    kPlanVersion     = 1;
+constexpr size_t      kPlanIdLength    = 64;    // ID定长存储（含结尾'\0'），超长部分截断
+constexpr const char *kDefaultPlanPath = "/dev/shm/rtd_dispatch_plan";
+
+struct PlanHeader {
+        uint32_t              magic;
+        uint32_t              version;
+        std::atomic<uint32_t> superseded;    // 已被新快照替换
+        uint32_t              reserved;
+        uint64_t              sequence;          // 发布序号
+        double                releaseTime;       // 方案发布时间(Unix时间戳)
+        double                makespan;          // 方案完工时间
+        uint64_t              equipmentCount;    // 设备数量
+        uint64_t              entryCount;        // 派工条目数量
+        uint64_t              equipmentOffset;   // PlanEquipment数组偏移
+        uint64_t              entryOffset;       // PlanEntry数组偏移
+};
+
+struct PlanEquipment {
+        char     eqpId[kPlanIdLength];
+        uint64_t firstEntry;    // 该设备第一个派工条目的下标
+        uint64_t entryCount;    // 该设备的派工条目数量（按开始时间排序）
+};
+
+struct PlanEntry {
+        char   lotId[kPlanIdLength];
+        double processingTime;
+        double startTime;
+        double endTime;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "superseded flag must be lock free across processes");
+
+}    // namespace dispatch
+}    // namespace rtd
@@ -0,0 +1,39 @@
+-- 为rtd_schedule的增量快照给Oracle主数据表增加行版本号和软删除标记，用法:
+--   sqlplus rtd/<password>@<tns> @common/sql/oracle/migrate_snapshot_delta.sql
+-- 执行后需要:
+--   1. 把api.json中getDataVersion、getEqpListDelta、getLotEqpRelationDelta、getProcessTimeDelta
+--      四个查询的"enabled"改为true（只启用其中一部分时仍按全量加载）
+--   2. 删除主数据改为把DELETED置为1；同时在getEqpList、getLotListByEqpId、getLotEqpRelation、
+--      getProcessTimeMatrix、getProcessTimeByLot的条件中加上 AND DELETED = 0，
+--      否则全量加载仍会读到已删除的行
+-- Oracle上处理时间与getProcessTime一样读EQPLIST，所以只需要迁移EQPLIST和LOTLIST两张表
+-- ROW_VERSION取自序列，事务的提交顺序与取号顺序可能不同：号码较小的事务在一次增量查询之后才提交时，
+-- 这次变更会被漏掉，由schedule.json中snapshot.full_reload_cycles的定期全量加载兜底，不要设为0
+
+-- 行版本号和软删除标记，已有的行版本号为0，在第一次全量加载时读入
+ALTER TABLE EQPLIST ADD (DELETED NUMBER(1) DEFAULT 0 NOT NULL, ROW_VERSION NUMBER DEFAULT 0 NOT NULL);
+ALTER TABLE LOTLIST ADD (DELETED NUMBER(1) DEFAULT 0 NOT NULL, ROW_VERSION NUMBER DEFAULT 0 NOT NULL);
+
+-- 增量查询按 ROW_VERSION > :since 过滤，getDataVersion取MAX(ROW_VERSION)，都走这些索引
+CREATE INDEX EQPLIST_VERSION ON EQPLIST (ROW_VERSION);
+CREATE INDEX LOTLIST_VERSION ON LOTLIST (ROW_VERSION);
+
+-- 两张表共用一个递增序列，版本号在表间可比较
+CREATE SEQUENCE RTD_DATA_VERSION START WITH 1 INCREMENT BY 1 NOCACHE;
+
+-- 插入和更新时写入新的行版本号
+CREATE OR REPLACE TRIGGER EQPLIST_VERSION
+BEFORE INSERT OR UPDATE ON EQPLIST
+FOR EACH ROW
+BEGIN
+    :NEW.ROW_VERSION := RTD_DATA_VERSION.NEXTVAL;
+END;
+/
+
+CREATE OR REPLACE TRIGGER LOTLIST_VERSION
+BEFORE INSERT OR UPDATE ON LOTLIST
+FOR EACH ROW
+BEGIN
+    :NEW.ROW_VERSION := RTD_DATA_VERSION.NEXTVAL;
+END;
+/
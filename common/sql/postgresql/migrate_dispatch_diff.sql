@@ -0,0 +1,30 @@
+-- 把已有的全量追加dispatch表迁移为差量写入所需的结构，用法:
+--   psql -d rtd -f common/sql/postgresql/migrate_dispatch_diff.sql
+-- 在停止rtd_schedule后执行，可重复执行。迁移后dispatch表每个批次一行，
+-- 需同时把schedule.json中dispatch_write.diff设为true：全量插入会违反lot_id唯一约束
+
+BEGIN;
+
+-- 旧表没有自增主键时补上，已有的行按物理顺序编号
+ALTER TABLE dispatch ADD COLUMN IF NOT EXISTS id BIGSERIAL;
+
+-- 每个批次只保留最近一次发布的行（发布时间相同时取id较大的）
+DELETE FROM dispatch d
+USING dispatch newer
+WHERE d.lot_id = newer.lot_id
+  AND (d.solution_release_time, d.id) < (newer.solution_release_time, newer.id);
+
+DROP INDEX IF EXISTS dispatch_lot;
+CREATE UNIQUE INDEX IF NOT EXISTS dispatch_lot_unique ON dispatch (lot_id);
+CREATE INDEX IF NOT EXISTS dispatch_eqp ON dispatch (eqp_id);
+
+CREATE TABLE IF NOT EXISTS dispatch_release (
+    version      BIGINT           NOT NULL PRIMARY KEY,
+    release_time DOUBLE PRECISION NOT NULL,
+    inserted     INTEGER          NOT NULL,
+    updated      INTEGER          NOT NULL,
+    deleted      INTEGER          NOT NULL,
+    total        INTEGER          NOT NULL
+);
+
+COMMIT;
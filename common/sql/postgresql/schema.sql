@@ -0,0 +1,27 @@
+-- rtd_schedule和rtd_server的PostgreSQL数据源（派工结果）建表脚本，用法:
+--   psql -d rtd -f common/sql/postgresql/schema.sql
+-- 默认每轮全量插入，dispatch表按发布追加，lot_id不设唯一约束；
+-- 启用差量写入（schedule.json中dispatch_write.diff为true）前再执行migrate_dispatch_diff.sql
+
+-- 派工结果，rtd_schedule写入，rtd_server查询
+CREATE TABLE IF NOT EXISTS dispatch (
+    id                    BIGSERIAL        PRIMARY KEY,
+    eqp_id                VARCHAR(64)      NOT NULL,
+    lot_id                VARCHAR(64)      NOT NULL,
+    solution_release_time DOUBLE PRECISION NOT NULL,
+    start_time            DOUBLE PRECISION NOT NULL,
+    end_time              DOUBLE PRECISION NOT NULL
+);
+
+CREATE INDEX IF NOT EXISTS dispatch_lot ON dispatch (lot_id);
+CREATE INDEX IF NOT EXISTS dispatch_eqp ON dispatch (eqp_id);
+
+-- 每次差量发布的发布头
+CREATE TABLE IF NOT EXISTS dispatch_release (
+    version      BIGINT           NOT NULL PRIMARY KEY,
+    release_time DOUBLE PRECISION NOT NULL,
+    inserted     INTEGER          NOT NULL,
+    updated      INTEGER          NOT NULL,
+    deleted      INTEGER          NOT NULL,
+    total        INTEGER          NOT NULL
+);
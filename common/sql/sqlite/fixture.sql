@@ -0,0 +1,63 @@
+-- 本机SQLite数据源的造数脚本，需先执行schema.sql
+-- 生成fixture_size中指定规模的设备、批次和处理时间（默认规模与基准测试的合成算例相同），
+-- 以及查询服务用的eqp、lot信息；派工表清空，由rtd_schedule写入。
+-- 数据由编号计算得出，重复执行得到相同的数据；ID形如EQP001、LOT001，与test_api.sh一致
+
+CREATE TEMP TABLE fixture_size AS
+SELECT 40  AS equipments,          -- 设备数
+       500 AS lots,                -- 批次数
+       30  AS density_percent,     -- 每个批次可加工的设备比例(%)
+       10  AS min_time,            -- 最短处理时间
+       120 AS max_time;            -- 最长处理时间
+
+BEGIN;
+
+DELETE FROM dispatch;
+DELETE FROM dispatch_release;
+DELETE FROM eqp;
+DELETE FROM lot;
+DELETE FROM PROCESS_COMPATIBILITY;
+DELETE FROM LOTLIST;
+DELETE FROM EQPLIST;
+
+CREATE TEMP TABLE fixture_eqp AS
+WITH RECURSIVE seq(n) AS (
+    SELECT 1
+    UNION ALL
+    SELECT n + 1 FROM seq WHERE n < (SELECT equipments FROM fixture_size)
+)
+SELECT n, printf('EQP%03d', n) AS eqp_id FROM seq;
+
+CREATE TEMP TABLE fixture_lot AS
+WITH RECURSIVE seq(n) AS (
+    SELECT 1
+    UNION ALL
+    SELECT n + 1 FROM seq WHERE n < (SELECT lots FROM fixture_size)
+)
+SELECT n, printf('LOT%03d', n) AS lot_id FROM seq;
+
+-- 可加工配对：按编号散列取density_percent%的设备，另保证每个批次至少有一台设备
+CREATE TEMP TABLE fixture_pair AS
+SELECT l.lot_id,
+       e.eqp_id,
+       s.min_time + (l.n * 31 + e.n * 17) % (s.max_time - s.min_time + 1) AS process_time
+FROM fixture_lot l, fixture_eqp e, fixture_size s
+WHERE (l.n * 7919 + e.n * 104729) % 100 < s.density_percent
+   OR e.n = l.n % s.equipments + 1;
+
+INSERT INTO EQPLIST (EQP_ID) SELECT eqp_id FROM fixture_eqp;
+INSERT INTO LOTLIST (LOT_ID, EQP_ID) SELECT lot_id, eqp_id FROM fixture_pair;
+INSERT INTO PROCESS_COMPATIBILITY (LOT_ID, EQP_ID, PROCESS_TIME) SELECT lot_id, eqp_id, process_time FROM fixture_pair;
+
+INSERT INTO eqp (id, name, type, status)
+SELECT eqp_id, 'Equipment ' || n, printf('TYPE%d', n % 4 + 1), 'IDLE' FROM fixture_eqp;
+
+INSERT INTO lot (id, product_id, quantity, priority, status)
+SELECT lot_id, printf('PRD%02d', n % 8 + 1), 25, n % 3 + 1, 'WAIT' FROM fixture_lot;
+
+COMMIT;
+
+DROP TABLE fixture_pair;
+DROP TABLE fixture_lot;
+DROP TABLE fixture_eqp;
+DROP TABLE fixture_size;
@@ -0,0 +1,138 @@
+-- rtd_schedule和rtd_server的本机SQLite数据源建表脚本
+-- 两个数据源（Oracle、PostgreSQL）可以指向同一个库文件，用法:
+--   sqlite3 /tmp/rtd_local.db < common/sql/sqlite/schema.sql
+--   sqlite3 /tmp/rtd_local.db < common/sql/sqlite/fixture.sql
+-- 然后把data_source.json中的数据源改为 "backend":"sqlite3"、"dsn_path":"./config/dsn/sqlite.dsn"
+
+-- WAL模式下调度读取主数据、写入派工和服务端查询可以并发进行（设置保存在库文件中）
+PRAGMA journal_mode = WAL;
+
+-- ---------------------------------------------------------------------------
+-- 调度主数据（rtd_schedule的Oracle数据源）
+-- ROW_VERSION列由触发器在插入和更新时写入DATA_VERSION的递增值；删除以DELETED = 1标记，
+-- 增量查询据此同步快照。Oracle上的同名列由common/sql/oracle/migrate_snapshot_delta.sql增加
+-- ---------------------------------------------------------------------------
+
+CREATE TABLE IF NOT EXISTS DATA_VERSION (
+    VERSION INTEGER NOT NULL
+);
+
+INSERT INTO DATA_VERSION (VERSION)
+SELECT 0 WHERE NOT EXISTS (SELECT 1 FROM DATA_VERSION);
+
+-- 设备
+CREATE TABLE IF NOT EXISTS EQPLIST (
+    EQP_ID      VARCHAR(64) NOT NULL PRIMARY KEY,
+    DELETED     INTEGER     NOT NULL DEFAULT 0,
+    ROW_VERSION INTEGER     NOT NULL DEFAULT 0
+);
+
+-- 批次与可加工设备
+CREATE TABLE IF NOT EXISTS LOTLIST (
+    LOT_ID      VARCHAR(64) NOT NULL,
+    EQP_ID      VARCHAR(64) NOT NULL,
+    DELETED     INTEGER     NOT NULL DEFAULT 0,
+    ROW_VERSION INTEGER     NOT NULL DEFAULT 0,
+    PRIMARY KEY (LOT_ID, EQP_ID)
+);
+
+CREATE INDEX IF NOT EXISTS LOTLIST_EQP ON LOTLIST (EQP_ID);
+
+-- 批次在设备上的处理时间
+CREATE TABLE IF NOT EXISTS PROCESS_COMPATIBILITY (
+    LOT_ID       VARCHAR(64) NOT NULL,
+    EQP_ID       VARCHAR(64) NOT NULL,
+    PROCESS_TIME REAL        NOT NULL,
+    DELETED      INTEGER     NOT NULL DEFAULT 0,
+    ROW_VERSION  INTEGER     NOT NULL DEFAULT 0,
+    PRIMARY KEY (LOT_ID, EQP_ID)
+);
+
+CREATE INDEX IF NOT EXISTS PROCESS_COMPATIBILITY_EQP ON PROCESS_COMPATIBILITY (EQP_ID);
+
+CREATE INDEX IF NOT EXISTS EQPLIST_VERSION ON EQPLIST (ROW_VERSION);
+CREATE INDEX IF NOT EXISTS LOTLIST_VERSION ON LOTLIST (ROW_VERSION);
+CREATE INDEX IF NOT EXISTS PROCESS_COMPATIBILITY_VERSION ON PROCESS_COMPATIBILITY (ROW_VERSION);
+
+-- 行版本号触发器（更新ROW_VERSION本身不会再次触发）
+CREATE TRIGGER IF NOT EXISTS EQPLIST_VERSION_INSERT AFTER INSERT ON EQPLIST
+BEGIN
+    UPDATE DATA_VERSION SET VERSION = VERSION + 1;
+    UPDATE EQPLIST SET ROW_VERSION = (SELECT VERSION FROM DATA_VERSION) WHERE rowid = NEW.rowid;
+END;
+
+CREATE TRIGGER IF NOT EXISTS EQPLIST_VERSION_UPDATE AFTER UPDATE OF EQP_ID, DELETED ON EQPLIST
+BEGIN
+    UPDATE DATA_VERSION SET VERSION = VERSION + 1;
+    UPDATE EQPLIST SET ROW_VERSION = (SELECT VERSION FROM DATA_VERSION) WHERE rowid = NEW.rowid;
+END;
+
+CREATE TRIGGER IF NOT EXISTS LOTLIST_VERSION_INSERT AFTER INSERT ON LOTLIST
+BEGIN
+    UPDATE DATA_VERSION SET VERSION = VERSION + 1;
+    UPDATE LOTLIST SET ROW_VERSION = (SELECT VERSION FROM DATA_VERSION) WHERE rowid = NEW.rowid;
+END;
+
+CREATE TRIGGER IF NOT EXISTS LOTLIST_VERSION_UPDATE AFTER UPDATE OF LOT_ID, EQP_ID, DELETED ON LOTLIST
+BEGIN
+    UPDATE DATA_VERSION SET VERSION = VERSION + 1;
+    UPDATE LOTLIST SET ROW_VERSION = (SELECT VERSION FROM DATA_VERSION) WHERE rowid = NEW.rowid;
+END;
+
+CREATE TRIGGER IF NOT EXISTS PROCESS_COMPATIBILITY_VERSION_INSERT AFTER INSERT ON PROCESS_COMPATIBILITY
+BEGIN
+    UPDATE DATA_VERSION SET VERSION = VERSION + 1;
+    UPDATE PROCESS_COMPATIBILITY SET ROW_VERSION = (SELECT VERSION FROM DATA_VERSION) WHERE rowid = NEW.rowid;
+END;
+
+CREATE TRIGGER IF NOT EXISTS PROCESS_COMPATIBILITY_VERSION_UPDATE AFTER UPDATE OF LOT_ID, EQP_ID, PROCESS_TIME, DELETED ON PROCESS_COMPATIBILITY
+BEGIN
+    UPDATE DATA_VERSION SET VERSION = VERSION + 1;
+    UPDATE PROCESS_COMPATIBILITY SET ROW_VERSION = (SELECT VERSION FROM DATA_VERSION) WHERE rowid = NEW.rowid;
+END;
+
+-- ---------------------------------------------------------------------------
+-- 查询服务的设备和批次信息（rtd_server的Oracle数据源）
+-- ---------------------------------------------------------------------------
+
+CREATE TABLE IF NOT EXISTS eqp (
+    id     VARCHAR(64) NOT NULL PRIMARY KEY,
+    name   VARCHAR(128),
+    type   VARCHAR(32),
+    status VARCHAR(16)
+);
+
+CREATE TABLE IF NOT EXISTS lot (
+    id         VARCHAR(64) NOT NULL PRIMARY KEY,
+    product_id VARCHAR(64),
+    quantity   INTEGER,
+    priority   INTEGER,
+    status     VARCHAR(16)
+);
+
+-- ---------------------------------------------------------------------------
+-- 派工结果（PostgreSQL数据源，rtd_schedule写入，rtd_server查询）
+-- 差量写入时每个批次一行；全量插入方式每轮追加，所以lot_id不设唯一约束
+-- ---------------------------------------------------------------------------
+
+CREATE TABLE IF NOT EXISTS dispatch (
+    id                    INTEGER     PRIMARY KEY AUTOINCREMENT,
+    eqp_id                VARCHAR(64) NOT NULL,
+    lot_id                VARCHAR(64) NOT NULL,
+    solution_release_time REAL        NOT NULL,
+    start_time            REAL        NOT NULL,
+    end_time              REAL        NOT NULL
+);
+
+CREATE INDEX IF NOT EXISTS dispatch_lot ON dispatch (lot_id);
+CREATE INDEX IF NOT EXISTS dispatch_eqp ON dispatch (eqp_id);
+
+-- 每次差量发布的发布头
+CREATE TABLE IF NOT EXISTS dispatch_release (
+    version      INTEGER NOT NULL PRIMARY KEY,
+    release_time REAL    NOT NULL,
+    inserted     INTEGER NOT NULL,
+    updated      INTEGER NOT NULL,
+    deleted      INTEGER NOT NULL,
+    total        INTEGER NOT NULL
+);
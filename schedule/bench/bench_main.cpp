@@ -0,0 +1,374 @@
+#include "instance_generator.h"
+#include "instance_loader.h"
+#include "job_scheduler.h"
+#include "quality_report.h"
+#include "schedule_chromosome.h"
+#include "schedule_evaluator.h"
+#include "schedule_probe.h"
+#include "schedule_two_part_chromosome.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+using namespace rtd::schedule;
+using namespace rtd::schedule::bench;
+using json = nlohmann::json;
+
+namespace {
+
+// 基准测试结果
+struct BenchResult {
+        std::string name;
+        size_t      iterations;
+        double      totalMs;
+        double      nsPerOp;
+        double      makespan;    // 仅完整求解有效，其余为-1
+};
+
+// 基准测试参数
+struct BenchOptions {
+        InstanceSpec       instance;
+        size_t             iterations  = 2000;    // 算子微基准的重复次数
+        size_t             repeat      = 3;       // 完整求解的重复次数
+        size_t             generations = 100;
+        size_t             population  = 100;
+        size_t             islands     = 4;
+        size_t             threads     = 0;
+        size_t             chunk       = 0;    // 岛内子代分块大小
+        bool               pin         = false;
+        ChromosomeEncoding encoding    = ChromosomeEncoding::PERMUTATION;
+        std::string        format      = "json";
+        std::string        output;
+        std::string        trace;       // 插桩trace输出文件（需以RTD_SCHEDULE_PROFILE编译）
+        std::string        snapshot;    // rtd_schedule录制的问题快照，非空时代替合成算例
+};
+
+// 防止被测调用被编译器优化掉
+volatile double g_sink = 0.0;
+
+void printUsage(const char *program)
+{
+    std::cout << "用法: " << program << " [选项]\n"
+              << "      " << program << " report --instance PATH [选项]   标准算例质量报告\n"
+              << "  --lots N            批次数量 (默认500)\n"
+              << "  --machines N        机台数量 (默认40)\n"
+              << "  --density D         工艺兼容密度0~1 (默认0.3)\n"
+              << "  --dist NAME         处理时间分布 uniform|lognormal|bimodal (默认uniform)\n"
+              << "  --min-time T        最短处理时间 (默认10)\n"
+              << "  --max-time T        最长处理时间 (默认120)\n"
+              << "  --seed S            算例和求解的随机数种子 (默认1)\n"
+              << "  --iterations N      算子微基准的重复次数 (默认2000)\n"
+              << "  --repeat N          完整求解的重复次数 (默认3)\n"
+              << "  --generations N     完整求解的代数 (默认100)\n"
+              << "  --population N      种群规模 (默认100)\n"
+              << "  --islands N         岛数量 (默认4)\n"
+              << "  --threads N         演化线程数 (默认0)\n"
+              << "  --chunk N           岛内子代分块大小，0表示不在岛内并行 (默认0)\n"
+              << "  --pin 0|1           演化线程绑定CPU并按NUMA节点放置 (默认0)\n"
+              << "  --encoding NAME     染色体编码 permutation|two_part (默认permutation)\n"
+              << "  --format json|csv   输出格式 (默认json)\n"
+              << "  --output FILE       输出文件 (默认标准输出)\n"
+              << "  --trace FILE        导出插桩探针的Chrome trace (需以RTD_SCHEDULE_PROFILE编译)\n"
+              << "  --snapshot FILE     使用rtd_schedule录制的问题快照代替合成算例\n";
+}
+
+bool parseOptions(int argc, char *argv[], BenchOptions &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "缺少参数值: " << arg << std::endl;
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--lots") {
+            options.instance.lotCount = std::stoul(value);
+        }
+        else if (arg == "--machines") {
+            options.instance.machineCount = std::stoul(value);
+        }
+        else if (arg == "--density") {
+            options.instance.eligibilityDensity = std::stod(value);
+        }
+        else if (arg == "--dist") {
+            if (!parseTimeDistribution(value, options.instance.distribution)) {
+                std::cerr << "未知的处理时间分布: " << value << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--min-time") {
+            options.instance.minTime = std::stod(value);
+        }
+        else if (arg == "--max-time") {
+            options.instance.maxTime = std::stod(value);
+        }
+        else if (arg == "--seed") {
+            options.instance.seed = static_cast<unsigned>(std::stoul(value));
+        }
+        else if (arg == "--iterations") {
+            options.iterations = std::stoul(value);
+        }
+        else if (arg == "--repeat") {
+            options.repeat = std::stoul(value);
+        }
+        else if (arg == "--generations") {
+            options.generations = std::stoul(value);
+        }
+        else if (arg == "--population") {
+            options.population = std::stoul(value);
+        }
+        else if (arg == "--islands") {
+            options.islands = std::stoul(value);
+        }
+        else if (arg == "--threads") {
+            options.threads = std::stoul(value);
+        }
+        else if (arg == "--chunk") {
+            options.chunk = std::stoul(value);
+        }
+        else if (arg == "--pin") {
+            options.pin = value == "1";
+        }
+        else if (arg == "--encoding") {
+            if (!parseChromosomeEncoding(value, options.encoding)) {
+                std::cerr << "未知的染色体编码: " << value << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--format") {
+            options.format = value;
+        }
+        else if (arg == "--output") {
+            options.output = value;
+        }
+        else if (arg == "--trace") {
+            options.trace = value;
+        }
+        else if (arg == "--snapshot") {
+            options.snapshot = value;
+        }
+        else {
+            std::cerr << "未知参数: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (options.format != "json" && options.format != "csv") {
+        std::cerr << "未知的输出格式: " << options.format << std::endl;
+        return false;
+    }
+
+    return options.instance.lotCount > 0 && options.instance.machineCount > 0 && options.iterations > 0;
+}
+
+// 计时执行body共iterations次
+template <typename Body>
+BenchResult measure(const std::string &name, size_t iterations, Body &&body)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        body(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    return {name, iterations, elapsed.count() / 1e6, elapsed.count() / iterations, -1.0};
+}
+
+std::vector<BenchResult> runBenchmarks(const BenchInstance &instance, const BenchOptions &options)
+{
+    const size_t lotCount     = instance.lotIds.size();
+    const size_t machineCount = instance.machineIds.size();
+    const auto  &times        = instance.processingTimes;
+
+    std::vector<BenchResult> results;
+    std::mt19937             generator(options.instance.seed);
+    EligibilityTable         eligibility(lotCount, machineCount, times);
+
+    // 预先生成一组个体，各算子轮流使用
+    const size_t            poolSize = 64;
+    std::vector<Chromosome> pool;
+    for (size_t i = 0; i < poolSize; ++i) {
+        pool.push_back(Chromosome::createRandom(eligibility, generator));
+    }
+
+    results.push_back(measure("crossover", options.iterations, [&](size_t i) {
+        Chromosome child = pool[i % poolSize].crossover(pool[(i + 1) % poolSize], generator);
+        g_sink           = g_sink + child.getLength();
+    }));
+
+    results.push_back(measure("crossover_by_lot", options.iterations, [&](size_t i) {
+        Chromosome child = pool[i % poolSize].crossoverByLot(pool[(i + 1) % poolSize], eligibility, generator);
+        g_sink           = g_sink + child.getLength();
+    }));
+
+    // 在副本上变异，保持个体池不变；计时包含一次染色体复制
+    results.push_back(measure("mutate", options.iterations, [&](size_t i) {
+        Chromosome child = pool[i % poolSize];
+        child.mutate(0.2, generator);
+        g_sink = g_sink + child.getLength();
+    }));
+
+    results.push_back(measure("mutate_assignment", options.iterations, [&](size_t i) {
+        Chromosome child = pool[i % poolSize];
+        child.mutateAssignment(0.02, eligibility, generator);
+        g_sink = g_sink + child.getLength();
+    }));
+
+    // 修复交叉和变异后的子代；计时包含一次染色体复制
+    std::vector<Chromosome> offspring;
+    for (size_t i = 0; i < poolSize; ++i) {
+        Chromosome child = pool[i].crossover(pool[(i + 1) % poolSize], generator);
+        child.mutate(0.2, generator);
+        offspring.push_back(child);
+    }
+    results.push_back(measure("repair", options.iterations, [&](size_t i) {
+        Chromosome child = offspring[i % poolSize];
+        child.repair(eligibility, generator);
+        g_sink = g_sink + child.getLength();
+    }));
+
+    ScheduleEvaluator evaluator(lotCount, machineCount, times);
+    results.push_back(measure("evaluate", options.iterations, [&](size_t i) {
+        g_sink = g_sink + evaluator.evaluate(pool[i % poolSize]);
+    }));
+
+    // 完整求解，每次使用不同但固定的种子
+    for (size_t run = 0; run < options.repeat; ++run) {
+        auto scheduler = JobScheduler::create();
+        scheduler->setLots(instance.lotIds);
+        scheduler->setMachines(instance.machineIds);
+        scheduler->setProcessingTimes(times);
+        scheduler->setPopulationSize(options.population);
+        scheduler->setIslandCount(options.islands);
+        scheduler->setGenerationCount(options.generations);
+        scheduler->setThreadCount(options.threads);
+        scheduler->setOffspringChunkSize(options.chunk);
+        scheduler->setThreadAffinity(options.pin);
+        scheduler->setEncoding(options.encoding);
+        scheduler->setRandomSeed(options.instance.seed + static_cast<unsigned>(run));
+
+        Schedule    schedule;
+        BenchResult result = measure("calculate_schedule", 1, [&](size_t) {
+            schedule = scheduler->calculateSchedule();
+        });
+        result.makespan = schedule.makespan;
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+void writeJson(std::ostream &out, const BenchInstance &instance, const BenchOptions &options, const std::vector<BenchResult> &results)
+{
+    json root;
+    root["instance"] = {
+      {"name", instance.name},
+      {"lots", options.instance.lotCount},
+      {"machines", options.instance.machineCount},
+      {"density", options.instance.eligibilityDensity},
+      {"distribution", timeDistributionName(options.instance.distribution)},
+      {"min_time", options.instance.minTime},
+      {"max_time", options.instance.maxTime},
+      {"seed", options.instance.seed}};
+    root["ga"] = {
+      {"population", options.population},
+      {"islands", options.islands},
+      {"generations", options.generations},
+      {"threads", options.threads},
+      {"offspring_chunk", options.chunk},
+      {"pin_threads", options.pin},
+      {"encoding", chromosomeEncodingName(options.encoding)}};
+
+    root["results"] = json::array();
+    for (const auto &result: results) {
+        json item = {
+          {"benchmark", result.name},
+          {"iterations", result.iterations},
+          {"total_ms", result.totalMs},
+          {"ns_per_op", result.nsPerOp}};
+        if (result.makespan >= 0) {
+            item["makespan"] = result.makespan;
+        }
+        root["results"].push_back(item);
+    }
+
+    out << root.dump(2) << std::endl;
+}
+
+void writeCsv(std::ostream &out, const BenchInstance &instance, const std::vector<BenchResult> &results)
+{
+    out << "benchmark,instance,iterations,total_ms,ns_per_op,makespan\n";
+    for (const auto &result: results) {
+        out << result.name << ',' << instance.name << ',' << result.iterations << ','
+            << result.totalMs << ',' << result.nsPerOp << ',';
+        if (result.makespan >= 0) {
+            out << result.makespan;
+        }
+        out << '\n';
+    }
+}
+
+}    // namespace
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && std::string(argv[1]) == "report") {
+        return runQualityReport(argc - 1, argv + 1);
+    }
+
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    BenchInstance instance;
+    if (options.snapshot.empty()) {
+        instance = generateInstance(options.instance);
+    }
+    else {
+        if (!loadInstanceFile(options.snapshot, instance)) {
+            return 1;
+        }
+        options.instance.lotCount     = instance.lotIds.size();
+        options.instance.machineCount = instance.machineIds.size();
+    }
+
+    std::vector<BenchResult> results = runBenchmarks(instance, options);
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file.is_open()) {
+            std::cerr << "无法写入输出文件: " << options.output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &out = options.output.empty() ? std::cout : file;
+
+    if (options.format == "csv") {
+        writeCsv(out, instance, results);
+    }
+    else {
+        writeJson(out, instance, options, results);
+    }
+
+    if (!options.trace.empty()) {
+        if (!probe::kEnabled) {
+            std::cerr << "未以RTD_SCHEDULE_PROFILE编译，不导出trace" << std::endl;
+        }
+        else {
+            probe::printSummary(std::cerr);
+            probe::exportChromeTrace(options.trace);
+        }
+    }
+
+    return 0;
+}
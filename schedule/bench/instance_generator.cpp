@@ -0,0 +1,121 @@
+#include "instance_generator.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+
+namespace rtd {
+namespace schedule {
+namespace bench {
+
+namespace {
+
+double sampleTime(const InstanceSpec &spec, std::mt19937 &generator)
+{
+    double time = spec.minTime;
+
+    switch (spec.distribution) {
+        case TimeDistribution::UNIFORM:
+            time = std::uniform_real_distribution<double>(spec.minTime, spec.maxTime)(generator);
+            break;
+
+        case TimeDistribution::LOGNORMAL: {
+            // 中位数取区间的几何中点
+            double median = std::sqrt(spec.minTime * spec.maxTime);
+            time          = std::lognormal_distribution<double>(std::log(median), 0.5)(generator);
+            break;
+        }
+
+        case TimeDistribution::BIMODAL: {
+            double span   = spec.maxTime - spec.minTime;
+            bool   isLong = std::bernoulli_distribution(0.5)(generator);
+            double mean   = isLong ? spec.minTime + 0.8 * span : spec.minTime + 0.2 * span;
+            time          = std::normal_distribution<double>(mean, 0.05 * span)(generator);
+            break;
+        }
+    }
+
+    // 保留一位小数，便于在CSV中核对
+    time = std::clamp(time, spec.minTime, spec.maxTime);
+    return std::round(time * 10.0) / 10.0;
+}
+
+}    // namespace
+
+BenchInstance generateInstance(const InstanceSpec &spec)
+{
+    std::mt19937 generator(spec.seed);
+
+    BenchInstance instance;
+
+    std::ostringstream name;
+    name << "syn_" << spec.lotCount << "x" << spec.machineCount << "_d" << spec.eligibilityDensity
+         << "_" << timeDistributionName(spec.distribution) << "_s" << spec.seed;
+    instance.name = name.str();
+
+    for (size_t i = 0; i < spec.lotCount; ++i) {
+        instance.lotIds.push_back("LOT" + std::to_string(i));
+    }
+    for (size_t j = 0; j < spec.machineCount; ++j) {
+        instance.machineIds.push_back("EQP" + std::to_string(j));
+    }
+
+    instance.processingTimes.assign(spec.lotCount, std::vector<double>(spec.machineCount, 0.0));
+
+    std::bernoulli_distribution           eligible(std::clamp(spec.eligibilityDensity, 0.0, 1.0));
+    std::uniform_int_distribution<size_t> anyMachine(0, spec.machineCount > 0 ? spec.machineCount - 1 : 0);
+
+    for (size_t i = 0; i < spec.lotCount && spec.machineCount > 0; ++i) {
+        // 同一批次在不同机台上的处理时间围绕基准时间波动，接近实际工艺
+        double base = sampleTime(spec, generator);
+
+        bool hasMachine = false;
+        for (size_t j = 0; j < spec.machineCount; ++j) {
+            if (eligible(generator)) {
+                double factor                  = std::uniform_real_distribution<double>(0.8, 1.2)(generator);
+                instance.processingTimes[i][j] = std::round(base * factor * 10.0) / 10.0;
+                hasMachine                     = true;
+            }
+        }
+
+        if (!hasMachine) {
+            instance.processingTimes[i][anyMachine(generator)] = base;
+        }
+    }
+
+    return instance;
+}
+
+bool parseTimeDistribution(const std::string &name, TimeDistribution &distribution)
+{
+    if (name == "uniform") {
+        distribution = TimeDistribution::UNIFORM;
+    }
+    else if (name == "lognormal") {
+        distribution = TimeDistribution::LOGNORMAL;
+    }
+    else if (name == "bimodal") {
+        distribution = TimeDistribution::BIMODAL;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+const char *timeDistributionName(TimeDistribution distribution)
+{
+    switch (distribution) {
+        case TimeDistribution::UNIFORM:
+            return "uniform";
+        case TimeDistribution::LOGNORMAL:
+            return "lognormal";
+        case TimeDistribution::BIMODAL:
+            return "bimodal";
+    }
+    return "unknown";
+}
+
+}    // namespace bench
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+namespace bench {
+
+/**
+ * 处理时间分布
+ */
+enum class TimeDistribution {
+    UNIFORM,      // [minTime, maxTime]均匀分布
+    LOGNORMAL,    // 对数正态分布，截断到[minTime, maxTime]，模拟少量超长工艺
+    BIMODAL       // 短工艺和长工艺各占一半，模拟不同产品族混排
+};
+
+/**
+ * 合成算例参数
+ */
+struct InstanceSpec {
+        size_t           lotCount           = 500;
+        size_t           machineCount       = 40;
+        double           eligibilityDensity = 0.3;    // 批次可在某机台加工的概率
+        TimeDistribution distribution       = TimeDistribution::UNIFORM;
+        double           minTime            = 10.0;
+        double           maxTime            = 120.0;
+        unsigned         seed               = 1;
+};
+
+/**
+ * 调度算例
+ */
+struct BenchInstance {
+        std::string                      name;
+        std::vector<std::string>         lotIds;
+        std::vector<std::string>         machineIds;
+        std::vector<std::vector<double>> processingTimes;    // 0表示不可加工
+};
+
+/**
+ * 生成确定性的合成算例
+ * 相同参数总是生成相同的算例，每个批次至少有一台可加工机台
+ */
+BenchInstance generateInstance(const InstanceSpec &spec);
+
+/**
+ * 解析分布名称(uniform/lognormal/bimodal)
+ * @return 是否解析成功
+ */
+bool parseTimeDistribution(const std::string &name, TimeDistribution &distribution);
+
+/**
+ * 分布名称
+ */
+const char *timeDistributionName(TimeDistribution distribution);
+
+}    // namespace bench
+}    // namespace schedule
+}    // namespace rtd
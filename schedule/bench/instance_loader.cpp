@@ -0,0 +1,143 @@
+#include "instance_loader.h"
+#include "problem_snapshot.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace rtd {
+namespace schedule {
+namespace bench {
+
+namespace {
+
+// 读取下一行非空、非注释的内容
+bool nextDataLine(std::ifstream &file, std::string &line)
+{
+    while (std::getline(file, line)) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first != std::string::npos && line[first] != '#') {
+            return true;
+        }
+    }
+    return false;
+}
+
+}    // namespace
+
+bool loadInstanceFile(const std::string &path, BenchInstance &instance)
+{
+    // rtd_schedule录制的问题快照
+    if (isProblemSnapshotFile(path)) {
+        MasterDataSnapshot snapshot;
+        if (!readProblemSnapshot(path, snapshot)) {
+            std::cerr << "问题快照文件格式无效: " << path << std::endl;
+            return false;
+        }
+
+        instance.name            = std::filesystem::path(path).filename().string();
+        instance.lotIds          = std::move(snapshot.lots);
+        instance.machineIds      = std::move(snapshot.equipments);
+        instance.processingTimes = std::move(snapshot.processingTimes);
+        return !instance.lotIds.empty() && !instance.machineIds.empty();
+    }
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "无法打开算例文件: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    size_t      lotCount     = 0;
+    size_t      machineCount = 0;
+    if (!nextDataLine(file, line) || !(std::istringstream(line) >> lotCount >> machineCount) || lotCount == 0 || machineCount == 0) {
+        std::cerr << "算例文件缺少有效的规模行: " << path << std::endl;
+        return false;
+    }
+
+    instance.name = std::filesystem::path(path).filename().string();
+    instance.lotIds.clear();
+    instance.machineIds.clear();
+    instance.processingTimes.assign(lotCount, std::vector<double>(machineCount, 0.0));
+
+    for (size_t i = 0; i < lotCount; ++i) {
+        if (!nextDataLine(file, line)) {
+            std::cerr << "算例文件在第 " << i << " 个批次处提前结束: " << path << std::endl;
+            return false;
+        }
+
+        std::istringstream  stream(line);
+        std::vector<double> values;
+        double              value;
+        while (stream >> value) {
+            values.push_back(value);
+        }
+
+        if (values.size() == 2 * machineCount) {
+            // "机台编号 处理时间"对
+            for (size_t k = 0; k < machineCount; ++k) {
+                double machine = values[2 * k];
+                if (machine < 0 || machine >= static_cast<double>(machineCount)) {
+                    std::cerr << "算例文件第 " << i << " 个批次的机台编号越界: " << path << std::endl;
+                    return false;
+                }
+                instance.processingTimes[i][static_cast<size_t>(machine)] = values[2 * k + 1];
+            }
+        }
+        else if (values.size() == machineCount) {
+            // 处理时间矩阵行
+            instance.processingTimes[i] = values;
+        }
+        else {
+            std::cerr << "算例文件第 " << i << " 个批次的列数不正确: " << path << std::endl;
+            return false;
+        }
+
+        for (double &time: instance.processingTimes[i]) {
+            time = std::max(time, 0.0);
+        }
+        if (std::none_of(instance.processingTimes[i].begin(), instance.processingTimes[i].end(), [](double time) { return time > 0; })) {
+            std::cerr << "算例文件第 " << i << " 个批次没有可加工机台: " << path << std::endl;
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < lotCount; ++i) {
+        instance.lotIds.push_back("J" + std::to_string(i));
+    }
+    for (size_t j = 0; j < machineCount; ++j) {
+        instance.machineIds.push_back("M" + std::to_string(j));
+    }
+
+    return true;
+}
+
+std::vector<std::string> expandInstancePaths(const std::vector<std::string> &paths)
+{
+    std::vector<std::string> files;
+
+    for (const auto &path: paths) {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(path, ec)) {
+            files.push_back(path);
+            continue;
+        }
+
+        std::vector<std::string> entries;
+        for (const auto &entry: std::filesystem::directory_iterator(path, ec)) {
+            if (entry.is_regular_file()) {
+                entries.push_back(entry.path().string());
+            }
+        }
+        std::sort(entries.begin(), entries.end());
+        files.insert(files.end(), entries.begin(), entries.end());
+    }
+
+    return files;
+}
+
+}    // namespace bench
+}    // namespace schedule
+}    // namespace rtd
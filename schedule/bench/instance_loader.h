@@ -0,0 +1,34 @@
+#pragma once
+
+#include "instance_generator.h"
+#include <string>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+namespace bench {
+
+/**
+ * 加载无关并行机(R||Cmax)标准算例文件
+ *
+ * 支持Vallada & Ruiz公开算例的格式:
+ *   第一行为"批次数 机台数"，随后每个批次一行，为"机台编号 处理时间"对；
+ * 也支持每行直接给出各机台处理时间的矩阵格式。
+ * 处理时间行之后的内容（如带准备时间算例的SSD段）忽略，因为调度模型不含准备时间。
+ * 处理时间小于等于0表示该批次不能在该机台加工。
+ * 也可以直接加载rtd_schedule录制的问题快照文件（snapshot.record_path）。
+ *
+ * @param path 算例文件路径
+ * @param instance 加载的算例，名称取文件名
+ * @return 是否加载成功
+ */
+bool loadInstanceFile(const std::string &path, BenchInstance &instance);
+
+/**
+ * 展开算例路径：目录展开为其中的所有普通文件（按文件名排序），文件原样返回
+ */
+std::vector<std::string> expandInstancePaths(const std::vector<std::string> &paths);
+
+}    // namespace bench
+}    // namespace schedule
+}    // namespace rtd
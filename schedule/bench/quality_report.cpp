@@ -0,0 +1,340 @@
+#include "quality_report.h"
+#include "instance_loader.h"
+#include "job_scheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace rtd {
+namespace schedule {
+namespace bench {
+
+namespace {
+
+// 报告参数
+struct ReportOptions {
+        std::vector<std::string> instances;
+        std::vector<unsigned>    seeds       = {1, 2, 3};
+        std::vector<size_t>      threads     = {1, 2, 4};
+        size_t                   generations = 200;
+        size_t                   population  = 100;
+        size_t                   islands     = 4;
+        size_t                   chunk       = 0;    // 岛内子代分块大小
+        ChromosomeEncoding       encoding    = ChromosomeEncoding::PERMUTATION;
+        std::string              format      = "json";
+        std::string              output;
+};
+
+// 一次求解的结果
+struct RunRecord {
+        std::string                 instance;
+        unsigned                    seed;
+        size_t                      threads;
+        double                      wallMs;
+        double                      makespan;
+        std::vector<SearchProgress> curve;
+};
+
+void printUsage(const char *program)
+{
+    std::cout << "用法: " << program << " report --instance PATH [选项]\n"
+              << "  --instance PATH     算例文件或目录，可重复指定\n"
+              << "  --seeds LIST        随机数种子，逗号分隔 (默认1,2,3)\n"
+              << "  --threads LIST      演化线程数，逗号分隔 (默认1,2,4)\n"
+              << "  --generations N     代数 (默认200)\n"
+              << "  --population N      种群规模 (默认100)\n"
+              << "  --islands N         岛数量 (默认4)\n"
+              << "  --chunk N           岛内子代分块大小，0表示不在岛内并行 (默认0)\n"
+              << "  --encoding NAME     染色体编码 permutation|two_part (默认permutation)\n"
+              << "  --format json|csv   输出格式 (默认json)\n"
+              << "  --output PATH       JSON输出文件；CSV时为文件名前缀，生成PATH_anytime.csv和PATH_speedup.csv\n";
+}
+
+template <typename T>
+bool parseList(const std::string &value, std::vector<T> &list)
+{
+    list.clear();
+    std::stringstream stream(value);
+    std::string       item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            list.push_back(static_cast<T>(std::stoul(item)));
+        }
+    }
+    return !list.empty();
+}
+
+bool parseOptions(int argc, char *argv[], ReportOptions &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h" || i + 1 >= argc) {
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--instance") {
+            options.instances.push_back(value);
+        }
+        else if (arg == "--seeds") {
+            if (!parseList(value, options.seeds)) return false;
+        }
+        else if (arg == "--threads") {
+            if (!parseList(value, options.threads)) return false;
+        }
+        else if (arg == "--generations") {
+            options.generations = std::stoul(value);
+        }
+        else if (arg == "--population") {
+            options.population = std::stoul(value);
+        }
+        else if (arg == "--islands") {
+            options.islands = std::stoul(value);
+        }
+        else if (arg == "--chunk") {
+            options.chunk = std::stoul(value);
+        }
+        else if (arg == "--format") {
+            options.format = value;
+        }
+        else if (arg == "--output") {
+            options.output = value;
+        }
+        else if (arg == "--encoding") {
+            if (!parseChromosomeEncoding(value, options.encoding)) {
+                std::cerr << "未知的染色体编码: " << value << std::endl;
+                return false;
+            }
+        }
+        else {
+            std::cerr << "未知参数: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    std::sort(options.threads.begin(), options.threads.end());
+    return !options.instances.empty() && (options.format == "json" || options.format == "csv");
+}
+
+RunRecord runOnce(const BenchInstance &instance, const ReportOptions &options, unsigned seed, size_t threads)
+{
+    RunRecord record {instance.name, seed, threads, 0.0, 0.0, {}};
+
+    auto scheduler = JobScheduler::create();
+    scheduler->setLots(instance.lotIds);
+    scheduler->setMachines(instance.machineIds);
+    scheduler->setProcessingTimes(instance.processingTimes);
+    scheduler->setPopulationSize(options.population);
+    scheduler->setIslandCount(options.islands);
+    scheduler->setGenerationCount(options.generations);
+    scheduler->setEncoding(options.encoding);
+    scheduler->setRandomSeed(seed);
+    scheduler->setThreadCount(threads);
+    scheduler->setOffspringChunkSize(options.chunk);
+    scheduler->setProgressCallback([&record](const SearchProgress &progress) {
+        record.curve.push_back(progress);
+    });
+
+    auto     start    = std::chrono::steady_clock::now();
+    Schedule schedule = scheduler->calculateSchedule();
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    record.wallMs   = elapsed.count();
+    record.makespan = schedule.makespan;
+    return record;
+}
+
+// 加速比表的一行
+struct SpeedupRow {
+        std::string instance;
+        size_t      threads;
+        size_t      runs;
+        double      meanWallMs;
+        double      speedup;
+        double      meanMakespan;
+        double      bestMakespan;
+};
+
+std::vector<SpeedupRow> buildSpeedupTable(const std::vector<RunRecord> &records, const ReportOptions &options)
+{
+    std::vector<SpeedupRow>  rows;
+    std::vector<std::string> instances;
+    for (const auto &record: records) {
+        if (std::find(instances.begin(), instances.end(), record.instance) == instances.end()) {
+            instances.push_back(record.instance);
+        }
+    }
+
+    for (const auto &instance: instances) {
+        double baselineMs = 0.0;
+        for (size_t threads: options.threads) {
+            SpeedupRow row {instance, threads, 0, 0.0, 0.0, 0.0, std::numeric_limits<double>::max()};
+            for (const auto &record: records) {
+                if (record.instance == instance && record.threads == threads) {
+                    ++row.runs;
+                    row.meanWallMs += record.wallMs;
+                    row.meanMakespan += record.makespan;
+                    row.bestMakespan = std::min(row.bestMakespan, record.makespan);
+                }
+            }
+            if (row.runs == 0) {
+                continue;
+            }
+
+            row.meanWallMs /= row.runs;
+            row.meanMakespan /= row.runs;
+
+            // 以最少线程数的平均耗时为基准
+            if (baselineMs == 0.0) {
+                baselineMs = row.meanWallMs;
+            }
+            row.speedup = row.meanWallMs > 0 ? baselineMs / row.meanWallMs : 0.0;
+            rows.push_back(row);
+        }
+    }
+
+    return rows;
+}
+
+void writeJson(std::ostream &out, const std::vector<RunRecord> &records, const std::vector<SpeedupRow> &speedup, const ReportOptions &options)
+{
+    json root;
+    root["ga"] = {
+      {"population", options.population},
+      {"islands", options.islands},
+      {"generations", options.generations},
+      {"encoding", chromosomeEncodingName(options.encoding)}};
+
+    root["runs"] = json::array();
+    for (const auto &record: records) {
+        json curve = json::array();
+        for (const auto &point: record.curve) {
+            curve.push_back({
+              {"generation", point.generation},
+              {"evaluations", point.evaluations},
+              {"elapsed_ms", point.elapsedSeconds * 1000.0},
+              {"best_makespan", point.bestMakespan}});
+        }
+
+        root["runs"].push_back({
+          {"instance", record.instance},
+          {"seed", record.seed},
+          {"threads", record.threads},
+          {"wall_ms", record.wallMs},
+          {"makespan", record.makespan},
+          {"curve", curve}});
+    }
+
+    root["speedup"] = json::array();
+    for (const auto &row: speedup) {
+        root["speedup"].push_back({
+          {"instance", row.instance},
+          {"threads", row.threads},
+          {"runs", row.runs},
+          {"mean_wall_ms", row.meanWallMs},
+          {"speedup", row.speedup},
+          {"mean_makespan", row.meanMakespan},
+          {"best_makespan", row.bestMakespan}});
+    }
+
+    out << root.dump(2) << std::endl;
+}
+
+void writeAnytimeCsv(std::ostream &out, const std::vector<RunRecord> &records)
+{
+    out << "instance,seed,threads,generation,evaluations,elapsed_ms,best_makespan\n";
+    for (const auto &record: records) {
+        for (const auto &point: record.curve) {
+            out << record.instance << ',' << record.seed << ',' << record.threads << ','
+                << point.generation << ',' << point.evaluations << ','
+                << point.elapsedSeconds * 1000.0 << ',' << point.bestMakespan << '\n';
+        }
+    }
+}
+
+void writeSpeedupCsv(std::ostream &out, const std::vector<SpeedupRow> &speedup)
+{
+    out << "instance,threads,runs,mean_wall_ms,speedup,mean_makespan,best_makespan\n";
+    for (const auto &row: speedup) {
+        out << row.instance << ',' << row.threads << ',' << row.runs << ',' << row.meanWallMs << ','
+            << row.speedup << ',' << row.meanMakespan << ',' << row.bestMakespan << '\n';
+    }
+}
+
+}    // namespace
+
+int runQualityReport(int argc, char *argv[])
+{
+    ReportOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<RunRecord> records;
+    for (const auto &path: expandInstancePaths(options.instances)) {
+        BenchInstance instance;
+        if (!loadInstanceFile(path, instance)) {
+            continue;
+        }
+
+        std::cerr << "运行算例 " << instance.name << " (" << instance.lotIds.size() << "x" << instance.machineIds.size() << ")" << std::endl;
+        for (size_t threads: options.threads) {
+            for (unsigned seed: options.seeds) {
+                records.push_back(runOnce(instance, options, seed, threads));
+            }
+        }
+    }
+
+    if (records.empty()) {
+        std::cerr << "没有可运行的算例" << std::endl;
+        return 1;
+    }
+
+    std::vector<SpeedupRow> speedup = buildSpeedupTable(records, options);
+
+    if (options.format == "json") {
+        if (options.output.empty()) {
+            writeJson(std::cout, records, speedup, options);
+            return 0;
+        }
+
+        std::ofstream file(options.output);
+        if (!file.is_open()) {
+            std::cerr << "无法写入输出文件: " << options.output << std::endl;
+            return 1;
+        }
+        writeJson(file, records, speedup, options);
+        return 0;
+    }
+
+    if (options.output.empty()) {
+        writeAnytimeCsv(std::cout, records);
+        std::cout << '\n';
+        writeSpeedupCsv(std::cout, speedup);
+        return 0;
+    }
+
+    std::ofstream anytimeFile(options.output + "_anytime.csv");
+    std::ofstream speedupFile(options.output + "_speedup.csv");
+    if (!anytimeFile.is_open() || !speedupFile.is_open()) {
+        std::cerr << "无法写入输出文件: " << options.output << "_*.csv" << std::endl;
+        return 1;
+    }
+    writeAnytimeCsv(anytimeFile, records);
+    writeSpeedupCsv(speedupFile, speedup);
+    return 0;
+}
+
+}    // namespace bench
+}    // namespace schedule
+}    // namespace rtd
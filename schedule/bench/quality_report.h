@@ -0,0 +1,17 @@
+#pragma once
+
+namespace rtd {
+namespace schedule {
+namespace bench {
+
+/**
+ * 标准算例质量报告
+ * 在给定算例上以固定种子和不同线程数运行调度器，输出最优完工时间随耗时/评估次数变化的曲线，
+ * 以及各线程数下的平均耗时和加速比
+ * @return 进程退出码
+ */
+int runQualityReport(int argc, char *argv[]);
+
+}    // namespace bench
+}    // namespace schedule
+}    // namespace rtd
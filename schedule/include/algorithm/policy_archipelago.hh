@@ -0,0 +1,788 @@
+#pragma once
+
+#include "archipelago_ga.hh"
+#include "thread_affinity.hh"
+#include "work_stealing_pool.hh"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rtd {
+namespace algorithm {
+
+// 缓存行大小，各岛状态按此对齐，避免不同岛的线程写同一缓存行
+constexpr size_t kCacheLineSize = 64;
+
+/**
+ * 按缓存行对齐分配、长度补齐到整数个缓存行的分配器
+ * 各岛的种群和适应度缓冲区用它分配，首尾都不与其他堆块共享缓存行
+ */
+template<typename T>
+struct CacheLineAllocator {
+        using value_type = T;
+
+        CacheLineAllocator() = default;
+        template<typename U>
+        CacheLineAllocator(const CacheLineAllocator<U> &)
+        {
+        }
+
+        T *allocate(size_t n)
+        {
+            return static_cast<T *>(::operator new(paddedSize(n), std::align_val_t(kCacheLineSize)));
+        }
+
+        void deallocate(T *p, size_t n) { ::operator delete(p, paddedSize(n), std::align_val_t(kCacheLineSize)); }
+
+        static size_t paddedSize(size_t n) { return (n * sizeof(T) + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize; }
+
+        template<typename U>
+        bool operator==(const CacheLineAllocator<U> &) const
+        {
+            return true;
+        }
+        template<typename U>
+        bool operator!=(const CacheLineAllocator<U> &) const
+        {
+            return false;
+        }
+};
+
+template<typename T>
+using CacheLineVector = std::vector<T, CacheLineAllocator<T>>;
+
+/**
+ * 多岛遗传算法的运行参数
+ */
+struct ArchipelagoConfig {
+        size_t            islandCount         = 4;
+        size_t            populationPerIsland = 25;
+        size_t            elitismCount        = 2;
+        double            crossoverRate       = 0.8;
+        double            mutationRate        = 0.2;
+        size_t            migrationInterval   = 10;
+        double            migrationRate       = 0.1;
+        MigrationTopology topology            = MigrationTopology::RING;
+        size_t            threadCount         = 0;    // 0表示每个岛一个线程；启用岛内分块时表示硬件线程数
+        size_t            offspringChunk      = 0;    // 岛内子代分块大小，0表示每个岛在一个线程内演化
+        bool              pinThreads          = false;    // 把演化线程绑定到CPU，岛按NUMA节点分组放置
+};
+
+/**
+ * 一代中的算法阶段，供插桩策略区分耗时
+ */
+enum class GAPhase {
+    ISLAND,        // 单个岛的一代演化（包含以下各阶段）
+    SELECTION,
+    CROSSOVER,
+    MUTATION,
+    REPAIR,
+    EVALUATION,
+    MIGRATION
+};
+
+/**
+ * 锦标赛选择
+ * 从种群中随机抽取TournamentSize个个体，返回适应度最高者的下标
+ */
+template<size_t TournamentSize = 3>
+struct TournamentSelection {
+        template<typename Fitness, typename Alloc, typename Rng>
+        size_t select(const std::vector<Fitness, Alloc> &fitness, Rng &rng) const
+        {
+            std::uniform_int_distribution<size_t> dist(0, fitness.size() - 1);
+
+            size_t bestIdx = dist(rng);
+            for (size_t i = 1; i < TournamentSize; ++i) {
+                size_t idx = dist(rng);
+                if (fitness[idx] > fitness[bestIdx]) {
+                    bestIdx = idx;
+                }
+            }
+            return bestIdx;
+        }
+};
+
+/**
+ * 精英迁移：选出适应度最高的count个个体
+ */
+struct BestMigration {
+        template<typename Fitness, typename Alloc>
+        std::vector<size_t> select(const std::vector<Fitness, Alloc> &fitness, size_t count) const
+        {
+            std::vector<std::pair<Fitness, size_t>> ranked;
+            ranked.reserve(fitness.size());
+            for (size_t i = 0; i < fitness.size(); ++i) {
+                ranked.push_back({fitness[i], i});
+            }
+            std::sort(ranked.begin(), ranked.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+
+            std::vector<size_t> selected;
+            for (size_t i = 0; i < count && i < ranked.size(); ++i) {
+                selected.push_back(ranked[i].second);
+            }
+            return selected;
+        }
+};
+
+/**
+ * 不做修复（算子本身保证可行性时使用）
+ */
+struct NoRepair {
+        template<typename Genotype, typename Rng>
+        void repair(Genotype &, Rng &) const {}
+};
+
+/**
+ * 不做插桩
+ */
+struct NullInstrumentation {
+        struct Tally {};
+
+        struct Scope {
+                Scope(const NullInstrumentation &, GAPhase, size_t) {}
+                Scope(const NullInstrumentation &, GAPhase, Tally &) {}
+        };
+
+        void commit(size_t, const Tally &) const {}
+};
+
+/**
+ * 基于策略的多岛遗传算法引擎（仅头文件）
+ *
+ * 遗传操作作为模板策略在编译期确定，可被内联进代际循环:
+ *   Evaluator       Fitness evaluate(const Genotype &) const，适应度越大越好，需可被多个岛线程并发调用
+ *   Selection       size_t select(const FitnessList &, Rng &) const
+ *   Crossover       Genotype cross(const Genotype &, const Genotype &, Rng &) const
+ *   Mutation        void mutate(Genotype &, double rate, Rng &) const
+ *   Repair          void repair(Genotype &, Rng &) const
+ *   Migration       std::vector<size_t> select(const FitnessList &, size_t count) const
+ *   Instrumentation 嵌套类型Scope(const Instrumentation &, GAPhase, size_t island)，作用域内计时；
+ *                   子代生成中的Scope(const Instrumentation &, GAPhase, Tally &)计入分块局部的Tally，
+ *                   分块结束后由岛线程调用void commit(size_t island, const Tally &) const并入
+ *
+ * 每个岛使用独立的随机数生成器，各岛最优解在代末归约，固定种子时结果与线程数无关。
+ * 设置offspringChunk后，岛和岛内的子代分块都提交到共享的工作窃取线程池，
+ * 每块的随机数生成器由岛的生成器按块序派生，分块方式只取决于种群规模，结果同样与线程数无关。
+ * 种群和适应度缓冲区按缓存行对齐并在各代间复用，分块边界取整到整缓存行，相邻分块不写同一缓存行。
+ * 设置pinThreads后演化线程按编号分块均分到各NUMA节点并绑定CPU，每个岛固定由一个线程演化，种群由该线程首次写入而分配在本节点；
+ * 启用岛内分块时线程池的线程轮流绑定到各节点。多节点时评估器（只读的处理时间矩阵）在每个节点复制一份，
+ * 线程总是使用自己所绑定CPU所在节点的副本。绑定只改变线程放置，不改变结果。
+ */
+template<typename Genotype,
+         typename Evaluator,
+         typename Selection,
+         typename Crossover,
+         typename Mutation,
+         typename Repair          = NoRepair,
+         typename Migration       = BestMigration,
+         typename Instrumentation = NullInstrumentation,
+         typename Rng             = std::mt19937>
+class PolicyArchipelago {
+    public:
+        using Fitness     = decltype(std::declval<const Evaluator &>().evaluate(std::declval<const Genotype &>()));
+        using Population  = CacheLineVector<Genotype>;
+        using FitnessList = CacheLineVector<Fitness>;
+
+        PolicyArchipelago(
+          const ArchipelagoConfig &config,
+          Evaluator                evaluator,
+          Selection                selection       = Selection(),
+          Crossover                crossover       = Crossover(),
+          Mutation                 mutation        = Mutation(),
+          Repair                   repair          = Repair(),
+          Migration                migration       = Migration(),
+          Instrumentation          instrumentation = Instrumentation())
+            : m_config(config), m_evaluator(std::move(evaluator)), m_selection(std::move(selection)), m_crossover(std::move(crossover)), m_mutation(std::move(mutation)), m_repair(std::move(repair)), m_migration(std::move(migration)), m_instrumentation(std::move(instrumentation))
+        {
+            buildTopology();
+            if (m_config.pinThreads) {
+                placeThreads();
+            }
+
+            if (m_config.offspringChunk > 0) {
+                size_t threads = m_config.threadCount;
+                if (threads == 0) {
+                    threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+                }
+                m_pool = std::make_unique<WorkStealingPool>(threads, m_cpuTopology.interleavedCpus());
+            }
+        }
+
+        /**
+         * 初始化种群
+         * 先用master依次为每个岛生成随机数种子，再按岛并行调用init(island, index, rng)生成每个个体并评估。
+         * rng为该岛的随机数生成器，init会被多个线程同时调用（岛不同），固定种子时结果与线程数无关
+         */
+        template<typename Init>
+        void initialize(Init &&init, Rng &master)
+        {
+            const size_t islands = m_config.islandCount;
+
+            m_islands = std::vector<IslandState>(islands);
+            for (auto &state: m_islands) {
+                state.rng.seed(master());
+            }
+
+            forEachIsland([this, &init](size_t island) {
+                IslandState &state = m_islands[island];
+                state.population.reserve(m_config.populationPerIsland);
+                state.fitness.reserve(m_config.populationPerIsland);
+
+                const Evaluator &evaluator = localEvaluator();
+                for (size_t i = 0; i < m_config.populationPerIsland; ++i) {
+                    state.population.push_back(init(island, i, state.rng));
+                    state.fitness.push_back(evaluator.evaluate(state.population.back()));
+                }
+            });
+
+            m_evaluations = islands * m_config.populationPerIsland;
+            m_generation  = 0;
+            resetBest();
+        }
+
+        /**
+         * 直接设置种群状态（例如从检查点恢复），最优解由种群重新归约
+         */
+        void restore(
+          std::vector<std::vector<Genotype>> populations,
+          std::vector<std::vector<Fitness>>  fitness,
+          std::vector<Rng>                   rngs,
+          size_t                             generation)
+        {
+            m_islands = std::vector<IslandState>(populations.size());
+            for (size_t island = 0; island < m_islands.size(); ++island) {
+                m_islands[island].population.assign(std::make_move_iterator(populations[island].begin()), std::make_move_iterator(populations[island].end()));
+                m_islands[island].fitness.assign(fitness[island].begin(), fitness[island].end());
+                m_islands[island].rng        = std::move(rngs[island]);
+            }
+            m_generation = generation;
+            resetBest();
+        }
+
+        /**
+         * 所有岛演化一代，随后归约全局最优解
+         * 线程数少于岛数时每个线程依次演化多个岛
+         */
+        void evolveGeneration()
+        {
+            forEachIsland([this](size_t island) { evolveIsland(island); });
+
+            reduceBest();
+            ++m_generation;
+        }
+
+        /**
+         * 连续演化若干代，每migrationInterval代按拓扑迁移一次
+         */
+        void evolve(size_t generations)
+        {
+            for (size_t gen = 0; gen < generations; ++gen) {
+                evolveGeneration();
+                if (m_config.migrationInterval > 0 && (gen + 1) % m_config.migrationInterval == 0) {
+                    migrate();
+                }
+            }
+        }
+
+        /**
+         * 按拓扑在岛之间迁移个体
+         */
+        void migrate()
+        {
+            typename Instrumentation::Scope scope(m_instrumentation, GAPhase::MIGRATION, 0);
+
+            const size_t count = migrantCount();
+            for (size_t source = 0; source < m_config.islandCount; ++source) {
+                std::vector<Genotype> migrants = selectMigrants(source, count);
+
+                for (size_t dest = 0; dest < m_config.islandCount; ++dest) {
+                    if (dest == source || !m_topology[source][dest]) {
+                        continue;
+                    }
+                    for (const auto &migrant: migrants) {
+                        acceptMigrant(dest, migrant);
+                    }
+                }
+            }
+        }
+
+        /**
+         * 选出岛中的移民
+         */
+        std::vector<Genotype> selectMigrants(size_t island, size_t count) const
+        {
+            std::vector<Genotype> migrants;
+            for (size_t idx: m_migration.select(m_islands[island].fitness, count)) {
+                migrants.push_back(m_islands[island].population[idx]);
+            }
+            return migrants;
+        }
+
+        /**
+         * 移民比目标岛最差个体更好时替换之
+         * @return 是否被接收
+         */
+        bool acceptMigrant(size_t island, const Genotype &migrant)
+        {
+            auto  &fitness  = m_islands[island].fitness;
+            size_t worstIdx = static_cast<size_t>(std::min_element(fitness.begin(), fitness.end()) - fitness.begin());
+
+            Fitness migrantFitness = m_evaluator.evaluate(migrant);
+            ++m_evaluations;
+
+            if (!(migrantFitness > fitness[worstIdx])) {
+                return false;
+            }
+
+            m_islands[island].population[worstIdx] = migrant;
+            fitness[worstIdx]                      = migrantFitness;
+            if (!m_hasBest || migrantFitness > m_bestFitness) {
+                m_bestFitness = migrantFitness;
+                m_best        = migrant;
+                m_hasBest     = true;
+            }
+            return true;
+        }
+
+        // 每次迁移的移民数量（至少一个）
+        size_t migrantCount() const
+        {
+            size_t count = static_cast<size_t>(m_config.populationPerIsland * m_config.migrationRate);
+            return count == 0 ? 1 : count;
+        }
+
+        // 状态访问
+        const ArchipelagoConfig                  &config() const { return m_config; }
+        const Evaluator                          &evaluator() const { return m_evaluator; }
+        const Population                         &population(size_t island) const { return m_islands[island].population; }
+        const FitnessList                        &fitness(size_t island) const { return m_islands[island].fitness; }
+        const Rng                                &rng(size_t island) const { return m_islands[island].rng; }
+        const Genotype                           &best() const { return m_best; }
+        Fitness                                   bestFitness() const { return m_bestFitness; }
+        size_t                                    generation() const { return m_generation; }
+        size_t                                    evaluations() const { return m_evaluations; }
+
+    private:
+        ArchipelagoConfig m_config;
+        Evaluator         m_evaluator;
+        Selection         m_selection;
+        Crossover         m_crossover;
+        Mutation          m_mutation;
+        Repair            m_repair;
+        Migration         m_migration;
+        Instrumentation   m_instrumentation;
+
+        // 岛本代评估过的最优个体（含未进入新种群的子代），代末归约
+        struct IslandBest {
+                Genotype genotype;
+                Fitness  fitness = std::numeric_limits<Fitness>::lowest();
+                bool     valid   = false;
+        };
+
+        /**
+         * 单个岛的全部可写状态，按缓存行对齐并填充到整数个缓存行，
+         * 演化时各岛线程只写自己的IslandState，不与其他岛共享缓存行。
+         * next*为下一代的缓冲区，每代结束时与当前种群交换，分配一次后各代复用
+         */
+        struct alignas(kCacheLineSize) IslandState {
+                Population  population;
+                FitnessList fitness;
+                Population  nextPopulation;
+                FitnessList nextFitness;
+                Rng         rng;
+                IslandBest  best;
+                size_t      evaluations = 0;    // 本代评估次数，代末归约
+        };
+
+        std::vector<IslandState>          m_islands;
+        std::vector<std::vector<bool>>    m_topology;
+        std::unique_ptr<WorkStealingPool> m_pool;    // 仅启用岛内分块时创建
+
+        // 线程放置（仅pinThreads时有效）：各演化线程绑定的CPU、CPU所在的节点，多节点时每个节点一份评估器副本
+        CpuTopology                             m_cpuTopology;
+        std::vector<int>                        m_workerCpu;
+        std::vector<int>                        m_cpuNode;
+        std::vector<std::unique_ptr<Evaluator>> m_nodeEvaluators;
+
+        Genotype m_best;
+        Fitness  m_bestFitness = std::numeric_limits<Fitness>::lowest();
+        bool     m_hasBest     = false;
+        size_t   m_generation  = 0;
+        size_t   m_evaluations = 0;
+
+        // 不使用线程池时的演化线程数
+        size_t workerCount() const
+        {
+            const size_t islands = m_config.islandCount;
+            return m_config.threadCount == 0 ? islands : std::min(m_config.threadCount, islands);
+        }
+
+        /**
+         * 对每个岛执行fn(island)
+         * 有线程池时提交到线程池；否则第w个线程依次处理第w, w+线程数, ...个岛，只有一个线程时直接在调用线程上执行
+         */
+        template<typename Fn>
+        void forEachIsland(Fn &&fn)
+        {
+            const size_t islands = m_config.islandCount;
+            if (m_pool) {
+                m_pool->parallelFor(islands, [&fn](size_t island) { fn(island); });
+                return;
+            }
+
+            const size_t workerCount = this->workerCount();
+            if (workerCount <= 1) {
+                for (size_t island = 0; island < islands; ++island) {
+                    fn(island);
+                }
+                return;
+            }
+
+            std::vector<std::thread> threads;
+            for (size_t worker = 0; worker < workerCount; ++worker) {
+                threads.emplace_back([this, &fn, worker, workerCount, islands]() {
+                    if (!m_workerCpu.empty()) {
+                        pinCurrentThread(m_workerCpu[worker]);
+                    }
+                    for (size_t island = worker; island < islands; island += workerCount) {
+                        fn(island);
+                    }
+                });
+            }
+            for (auto &t: threads) {
+                t.join();
+            }
+        }
+
+        // 每个缓冲区中pairs对子代正好占满整数个缓存行的最小对数
+        template<typename T>
+        static constexpr size_t pairsPerCacheLine()
+        {
+            return std::lcm(kCacheLineSize, 2 * sizeof(T)) / (2 * sizeof(T));
+        }
+
+        /**
+         * 分块的子代对数：offspringChunk个子代向上取整，使每块在种群和适应度缓冲区中都占整数个缓存行
+         */
+        size_t chunkPairs() const
+        {
+            constexpr size_t align = std::lcm(pairsPerCacheLine<Genotype>(), pairsPerCacheLine<Fitness>());
+
+            const size_t pairs = std::max<size_t>((m_config.offspringChunk + 1) / 2, 1);
+            return (pairs + align - 1) / align * align;
+        }
+
+        /**
+         * 演化单个岛：精英保留，其余个体由选择、交叉、变异、修复产生
+         * 子代按对编号写入新种群的前部，精英放在末尾，使分块边界从缓冲区起点按缓存行对齐；
+         * 启用岛内分块时每chunkPairs()对子代为一块并行生成，各块的最优个体和评估次数按块序归约
+         */
+        void evolveIsland(size_t island)
+        {
+            typename Instrumentation::Scope islandScope(m_instrumentation, GAPhase::ISLAND, island);
+
+            // 岛固定在第island % 线程数个线程上演化，种群和评估器副本都在该线程所绑定的节点
+            assert(m_pool || m_workerCpu.size() <= 1 || pinnedCpu() < 0 || pinnedCpu() == m_workerCpu[island % m_workerCpu.size()]);
+
+            IslandState &state      = m_islands[island];
+            const auto  &population = state.population;
+            const auto  &fitness    = state.fitness;
+            const size_t size       = m_config.populationPerIsland;
+
+            Population  &newPopulation = state.nextPopulation;
+            FitnessList &newFitness    = state.nextFitness;
+            newPopulation.resize(size);
+            newFitness.resize(size);
+
+            const size_t elites    = std::min(m_config.elitismCount, size);
+            const size_t offspring = size - elites;
+
+            // 精英保留
+            {
+                typename Instrumentation::Scope scope(m_instrumentation, GAPhase::SELECTION, island);
+
+                std::vector<std::pair<Fitness, size_t>> ranked;
+                ranked.reserve(size);
+                for (size_t i = 0; i < size; ++i) {
+                    ranked.push_back({fitness[i], i});
+                }
+                std::sort(ranked.begin(), ranked.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+
+                for (size_t rank = 0; rank < elites; ++rank) {
+                    newPopulation[offspring + rank] = population[ranked[rank].second];
+                    newFitness[offspring + rank]    = ranked[rank].first;
+                }
+            }
+
+            // 子代成对产生，奇数个空位时最后一对的第二个子代只参与最优解
+            const size_t pairs      = (offspring + 1) / 2;
+            const size_t chunkPairs = this->chunkPairs();
+            const size_t chunks     = m_pool ? (pairs + chunkPairs - 1) / chunkPairs : 1;
+
+            if (chunks <= 1) {
+                typename Instrumentation::Tally tally {};
+                breed(island, state.rng, 0, pairs, offspring, newPopulation, newFitness, state.best, state.evaluations, tally);
+                m_instrumentation.commit(island, tally);
+            }
+            else {
+                std::vector<Rng> chunkRngs;
+                chunkRngs.reserve(chunks);
+                for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                    chunkRngs.emplace_back(state.rng());
+                }
+
+                std::vector<IslandBest>                      chunkBest(chunks);
+                std::vector<size_t>                          chunkEvaluations(chunks, 0);
+                std::vector<typename Instrumentation::Tally> chunkTallies(chunks);
+                m_pool->parallelFor(chunks, [&](size_t chunk) {
+                    const size_t first = chunk * chunkPairs;
+                    const size_t last  = std::min(first + chunkPairs, pairs);
+                    breed(island, chunkRngs[chunk], first, last, offspring, newPopulation, newFitness, chunkBest[chunk], chunkEvaluations[chunk], chunkTallies[chunk]);
+                });
+
+                for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                    if (chunkBest[chunk].valid) {
+                        offerBest(state.best, chunkBest[chunk].genotype, chunkBest[chunk].fitness);
+                    }
+                    state.evaluations += chunkEvaluations[chunk];
+                    m_instrumentation.commit(island, chunkTallies[chunk]);
+                }
+            }
+
+            state.population.swap(newPopulation);
+            state.fitness.swap(newFitness);
+        }
+
+        /**
+         * 产生第[first, last)对子代，第p对写入2p和2p + 1位置（只写offspring之前的位置）
+         * 只读当前种群，只写自己负责的位置和tally，可被同一个岛的多个分块并发调用
+         */
+        void breed(
+          size_t                           island,
+          Rng                             &rng,
+          size_t                           first,
+          size_t                           last,
+          size_t                           offspring,
+          Population                      &newPopulation,
+          FitnessList                     &newFitness,
+          IslandBest                      &best,
+          size_t                          &evaluations,
+          typename Instrumentation::Tally &tally)
+        {
+            const auto &population = m_islands[island].population;
+            const auto &fitness    = m_islands[island].fitness;
+
+            // 最优个体和评估次数先在局部累计，结束时写回一次
+            IslandBest localBest;
+            size_t     localEvaluations = 0;
+
+            std::uniform_real_distribution<double> chance(0.0, 1.0);
+            for (size_t pair = first; pair < last; ++pair) {
+                size_t parent1;
+                size_t parent2;
+                {
+                    typename Instrumentation::Scope scope(m_instrumentation, GAPhase::SELECTION, tally);
+                    parent1 = m_selection.select(fitness, rng);
+                    parent2 = m_selection.select(fitness, rng);
+                }
+
+                Genotype child1 = population[parent1];
+                Genotype child2 = population[parent2];
+
+                if (chance(rng) < m_config.crossoverRate) {
+                    typename Instrumentation::Scope scope(m_instrumentation, GAPhase::CROSSOVER, tally);
+                    child1 = m_crossover.cross(population[parent1], population[parent2], rng);
+                    child2 = m_crossover.cross(population[parent2], population[parent1], rng);
+                }
+
+                {
+                    typename Instrumentation::Scope scope(m_instrumentation, GAPhase::MUTATION, tally);
+                    m_mutation.mutate(child1, m_config.mutationRate, rng);
+                    m_mutation.mutate(child2, m_config.mutationRate, rng);
+                }
+
+                {
+                    typename Instrumentation::Scope scope(m_instrumentation, GAPhase::REPAIR, tally);
+                    m_repair.repair(child1, rng);
+                    m_repair.repair(child2, rng);
+                }
+
+                Fitness fitness1;
+                Fitness fitness2;
+                {
+                    typename Instrumentation::Scope scope(m_instrumentation, GAPhase::EVALUATION, tally);
+                    const Evaluator &evaluator = localEvaluator();
+                    fitness1                   = evaluator.evaluate(child1);
+                    fitness2                   = evaluator.evaluate(child2);
+                }
+                localEvaluations += 2;
+
+                offerBest(localBest, child1, fitness1);
+                offerBest(localBest, child2, fitness2);
+
+                const size_t slot   = 2 * pair;
+                newPopulation[slot] = std::move(child1);
+                newFitness[slot]    = fitness1;
+                if (slot + 1 < offspring) {
+                    newPopulation[slot + 1] = std::move(child2);
+                    newFitness[slot + 1]    = fitness2;
+                }
+            }
+
+            if (localBest.valid) {
+                offerBest(best, localBest.genotype, localBest.fitness);
+            }
+            evaluations += localEvaluations;
+        }
+
+        // 记录更优的个体
+        static void offerBest(IslandBest &best, const Genotype &candidate, Fitness fitness)
+        {
+            if (!best.valid || fitness > best.fitness) {
+                best.genotype = candidate;
+                best.fitness  = fitness;
+                best.valid    = true;
+            }
+        }
+
+        /**
+         * 归约各岛本代最优个体到全局最优解
+         */
+        void reduceBest()
+        {
+            for (size_t island = 0; island < m_config.islandCount; ++island) {
+                IslandState &state     = m_islands[island];
+                IslandBest  &candidate = state.best;
+                if (candidate.valid && (!m_hasBest || candidate.fitness > m_bestFitness)) {
+                    m_bestFitness = candidate.fitness;
+                    m_best        = std::move(candidate.genotype);
+                    m_hasBest     = true;
+                }
+                candidate.valid = false;
+
+                m_evaluations += state.evaluations;
+                state.evaluations = 0;
+            }
+        }
+
+        /**
+         * 从当前种群重新计算全局最优解
+         */
+        void resetBest()
+        {
+            m_hasBest     = false;
+            m_bestFitness = std::numeric_limits<Fitness>::lowest();
+
+            for (auto &state: m_islands) {
+                state.best        = IslandBest();
+                state.evaluations = 0;
+                for (size_t i = 0; i < state.fitness.size(); ++i) {
+                    offerBest(state.best, state.population[i], state.fitness[i]);
+                }
+            }
+            reduceBest();
+        }
+
+        // 当前线程使用的评估器：所绑定CPU所在节点的副本，未复制或线程未绑定时为共享的评估器
+        const Evaluator &localEvaluator() const
+        {
+            const int cpu = pinnedCpu();
+            if (m_nodeEvaluators.empty() || cpu < 0 || cpu >= static_cast<int>(m_cpuNode.size()) || m_cpuNode[cpu] < 0) {
+                return m_evaluator;
+            }
+            return *m_nodeEvaluators[m_cpuNode[cpu]];
+        }
+
+        /**
+         * 为演化线程选择CPU：不使用线程池时各线程按编号分块均分到各NUMA节点，线程池在构造时按节点轮流绑定
+         * 多节点时在绑定到各节点的线程上复制评估器，使副本按首次写入分配在该节点；检测不到CPU时不绑定
+         */
+        void placeThreads()
+        {
+            m_cpuTopology = CpuTopology::detect();
+            if (m_cpuTopology.empty()) {
+                return;
+            }
+
+            if (m_config.offspringChunk == 0) {
+                m_workerCpu = m_cpuTopology.spreadCpus(workerCount());
+            }
+
+            const size_t nodes = m_cpuTopology.nodeCount();
+            if (nodes <= 1) {
+                return;
+            }
+
+            m_cpuNode = m_cpuTopology.nodeOfCpu();
+            m_nodeEvaluators.resize(nodes);
+            for (size_t node = 0; node < nodes; ++node) {
+                std::thread([this, node]() {
+                    pinCurrentThread(m_cpuTopology.nodes[node].front());
+                    m_nodeEvaluators[node] = std::make_unique<Evaluator>(m_evaluator);
+                }).join();
+            }
+        }
+
+        /**
+         * 构建迁移拓扑矩阵
+         */
+        void buildTopology()
+        {
+            const size_t n = m_config.islandCount;
+            m_topology.assign(n, std::vector<bool>(n, false));
+
+            switch (m_config.topology) {
+                case MigrationTopology::RING:
+                    // 环形拓扑：每个岛只与相邻岛连接
+                    for (size_t i = 0; i < n; ++i) {
+                        m_topology[i][(i + 1) % n]     = true;
+                        m_topology[i][(i + n - 1) % n] = true;
+                    }
+                    break;
+
+                case MigrationTopology::FULLY_CONNECTED:
+                    // 全连接拓扑：每个岛与所有其他岛连接
+                    for (size_t i = 0; i < n; ++i) {
+                        for (size_t j = 0; j < n; ++j) {
+                            m_topology[i][j] = i != j;
+                        }
+                    }
+                    break;
+
+                case MigrationTopology::STAR:
+                    // 星形拓扑：中心岛(0)与所有其他岛连接
+                    for (size_t i = 1; i < n; ++i) {
+                        m_topology[0][i] = true;
+                        m_topology[i][0] = true;
+                    }
+                    break;
+
+                case MigrationTopology::MESH: {
+                    // 网格拓扑：每个岛与上下左右的岛连接
+                    size_t meshSize = std::max<size_t>(1, static_cast<size_t>(std::sqrt(n)));
+                    for (size_t i = 0; i < n; ++i) {
+                        size_t row = i / meshSize;
+                        size_t col = i % meshSize;
+                        if (row > 0) m_topology[i][i - meshSize] = true;
+                        if (i + meshSize < n) m_topology[i][i + meshSize] = true;
+                        if (col > 0) m_topology[i][i - 1] = true;
+                        if (col + 1 < meshSize && i + 1 < n) m_topology[i][i + 1] = true;
+                    }
+                    break;
+                }
+            }
+        }
+};
+
+}    // namespace algorithm
+}    // namespace rtd
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace rtd {
+namespace algorithm {
+
+/**
+ * CPU的NUMA拓扑（仅头文件，Linux下读取/sys，其他平台退化为空拓扑）
+ * 只包含当前进程允许运行的CPU，没有可用CPU的节点被忽略
+ */
+struct CpuTopology {
+        std::vector<std::vector<int>> nodes;    // 每个NUMA节点的CPU编号
+
+        size_t nodeCount() const
+        {
+            return nodes.size();
+        }
+
+        bool empty() const
+        {
+            return nodes.empty();
+        }
+
+        /**
+         * 检测当前进程可用的CPU及其所在的NUMA节点
+         * 读不到节点信息（单节点机器、容器未挂载/sys）时所有可用CPU归为一个节点
+         */
+        static CpuTopology detect()
+        {
+            CpuTopology topology;
+
+#ifdef __linux__
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+                return topology;
+            }
+
+            // 节点编号可能不连续，以online列表为准
+            std::string   online;
+            std::ifstream onlineFile("/sys/devices/system/node/online");
+            std::getline(onlineFile, online);
+
+            for (int node: parseCpuList(online)) {
+                std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                if (!file.is_open()) {
+                    continue;
+                }
+
+                std::string list;
+                std::getline(file, list);
+
+                std::vector<int> cpus;
+                for (int cpu: parseCpuList(list)) {
+                    if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+                        cpus.push_back(cpu);
+                    }
+                }
+                if (!cpus.empty()) {
+                    topology.nodes.push_back(std::move(cpus));
+                }
+            }
+
+            if (topology.nodes.empty()) {
+                std::vector<int> cpus;
+                for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                    if (CPU_ISSET(cpu, &allowed)) {
+                        cpus.push_back(cpu);
+                    }
+                }
+                if (!cpus.empty()) {
+                    topology.nodes.push_back(std::move(cpus));
+                }
+            }
+#endif
+
+            return topology;
+        }
+
+        /**
+         * 按节点轮流排列的CPU列表（节点0第1个、节点1第1个、节点0第2个……），用于把线程均匀分散到各节点
+         */
+        std::vector<int> interleavedCpus() const
+        {
+            std::vector<int> cpus;
+            for (size_t rank = 0;; ++rank) {
+                bool added = false;
+                for (const auto &node: nodes) {
+                    if (rank < node.size()) {
+                        cpus.push_back(node[rank]);
+                        added = true;
+                    }
+                }
+                if (!added) {
+                    return cpus;
+                }
+            }
+        }
+
+        /**
+         * 为count个线程各选一个CPU：线程按编号分块均分到各节点（前count/nodes个在节点0……），
+         * 节点内依次使用各CPU，线程多于CPU时轮流共用
+         */
+        std::vector<int> spreadCpus(size_t count) const
+        {
+            std::vector<int> cpus;
+            if (nodes.empty()) {
+                return cpus;
+            }
+
+            std::vector<size_t> used(nodes.size(), 0);
+            for (size_t thread = 0; thread < count; ++thread) {
+                const size_t node = thread * nodes.size() / count;
+                cpus.push_back(nodes[node][used[node]++ % nodes[node].size()]);
+            }
+            return cpus;
+        }
+
+        /**
+         * CPU编号到节点下标的映射表，不属于任何节点的CPU为-1
+         */
+        std::vector<int> nodeOfCpu() const
+        {
+            std::vector<int> table;
+            for (size_t node = 0; node < nodes.size(); ++node) {
+                for (int cpu: nodes[node]) {
+                    if (cpu >= static_cast<int>(table.size())) {
+                        table.resize(cpu + 1, -1);
+                    }
+                    table[cpu] = static_cast<int>(node);
+                }
+            }
+            return table;
+        }
+
+        /**
+         * 解析"0-3,8,10-11"格式的编号列表（CPU列表和节点列表格式相同）
+         */
+        static std::vector<int> parseCpuList(const std::string &list)
+        {
+            std::vector<int>  cpus;
+            std::stringstream stream(list);
+            std::string       range;
+            while (std::getline(stream, range, ',')) {
+                if (range.empty()) {
+                    continue;
+                }
+                try {
+                    size_t dash  = range.find('-');
+                    int    first = std::stoi(range.substr(0, dash));
+                    int    last  = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                    for (int cpu = first; cpu <= last; ++cpu) {
+                        cpus.push_back(cpu);
+                    }
+                }
+                catch (const std::exception &) {
+                    continue;
+                }
+            }
+            return cpus;
+        }
+};
+
+/**
+ * 当前线程经pinCurrentThread绑定的CPU，未绑定时为-1
+ */
+inline int &pinnedCpu()
+{
+    thread_local int cpu = -1;
+    return cpu;
+}
+
+/**
+ * 把当前线程绑定到指定CPU，失败或非Linux平台时返回false且不改变绑定
+ */
+inline bool pinCurrentThread(int cpu)
+{
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        return false;
+    }
+    pinnedCpu() = cpu;
+    return true;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+}    // namespace algorithm
+}    // namespace rtd
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "thread_affinity.hh"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rtd {
+namespace algorithm {
+
+/**
+ * 工作窃取线程池（仅头文件）
+ *
+ * 每个工作线程有自己的任务队列，从队尾取自己提交的任务，空闲时从其他队列的队首窃取。
+ * parallelFor可以在任务内部嵌套调用（例如岛任务内再拆分子代），
+ * 调用线程在等待期间也执行任务，因此嵌套调用不会因线程耗尽而死锁
+ */
+class WorkStealingPool {
+    public:
+        /**
+         * @param threadCount 参与计算的线程数（含调用线程），不大于1时所有任务在调用线程上顺序执行
+         * @param cpus 非空时工作线程依次绑定到这些CPU（调用线程不绑定）
+         */
+        explicit WorkStealingPool(size_t threadCount, std::vector<int> cpus = {})
+        {
+            const size_t workers = threadCount > 1 ? threadCount - 1 : 0;
+
+            // 0号队列供池外线程提交任务，其余队列各属于一个工作线程
+            for (size_t i = 0; i <= workers; ++i) {
+                m_queues.push_back(std::make_unique<Queue>());
+            }
+            for (size_t i = 1; i <= workers; ++i) {
+                int cpu = cpus.empty() ? -1 : cpus[(i - 1) % cpus.size()];
+                m_threads.emplace_back([this, i, cpu]() {
+                    if (cpu >= 0) {
+                        pinCurrentThread(cpu);
+                    }
+                    workerLoop(i);
+                });
+            }
+        }
+
+        ~WorkStealingPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (auto &t: m_threads) {
+                t.join();
+            }
+        }
+
+        WorkStealingPool(const WorkStealingPool &)            = delete;
+        WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+        /**
+         * 参与计算的线程数（含调用线程）
+         */
+        size_t threadCount() const
+        {
+            return m_threads.size() + 1;
+        }
+
+        /**
+         * 对[0, count)的每个下标执行fn(index)，全部完成后返回
+         * 下标之间的执行顺序和所在线程不确定，fn须只写各自下标对应的数据。
+         * fn抛出异常时其余尚未开始的下标不再执行，全部任务结束后在调用线程上重新抛出第一个异常
+         */
+        void parallelFor(size_t count, const std::function<void(size_t)> &fn)
+        {
+            if (m_threads.empty() || count <= 1) {
+                for (size_t i = 0; i < count; ++i) {
+                    fn(i);
+                }
+                return;
+            }
+
+            Job          job {&fn, {count}, {false}, {}, nullptr};
+            const size_t self = currentQueue();
+            m_pending.fetch_add(count);
+            {
+                std::lock_guard<std::mutex> lock(m_queues[self]->mutex);
+                for (size_t i = 0; i < count; ++i) {
+                    m_queues[self]->tasks.push_back({&job, i});
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+            }
+            m_wake.notify_all();
+
+            // 等待期间执行自己或其他线程的任务
+            while (job.remaining.load(std::memory_order_acquire) > 0) {
+                Task task;
+                if (take(self, task)) {
+                    run(task);
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+
+            if (job.error) {
+                std::rethrow_exception(job.error);
+            }
+        }
+
+    private:
+        struct Job {
+                const std::function<void(size_t)> *fn;
+                std::atomic<size_t>                remaining;
+                std::atomic<bool>                  failed;
+                std::mutex                         errorMutex;
+                std::exception_ptr                 error;    // 第一个异常，remaining归零后由调用线程读取
+        };
+
+        struct Task {
+                Job   *job   = nullptr;
+                size_t index = 0;
+        };
+
+        struct Queue {
+                std::mutex       mutex;
+                std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::vector<std::thread>            m_threads;
+        std::atomic<size_t>                 m_pending {0};
+        std::mutex                          m_sleepMutex;
+        std::condition_variable             m_wake;
+        bool                                m_stop = false;
+
+        // 当前线程所属的池和队列下标
+        static const WorkStealingPool *&currentPool()
+        {
+            thread_local const WorkStealingPool *pool = nullptr;
+            return pool;
+        }
+
+        static size_t &currentIndex()
+        {
+            thread_local size_t index = 0;
+            return index;
+        }
+
+        size_t currentQueue() const
+        {
+            return currentPool() == this ? currentIndex() : 0;
+        }
+
+        /**
+         * 先从自己的队尾取任务，再依次从其他队列的队首窃取
+         */
+        bool take(size_t self, Task &task)
+        {
+            if (m_pending.load(std::memory_order_acquire) == 0) {
+                return false;
+            }
+
+            {
+                Queue                      &own = *m_queues[self];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.tasks.empty()) {
+                    task = own.tasks.back();
+                    own.tasks.pop_back();
+                    m_pending.fetch_sub(1);
+                    return true;
+                }
+            }
+
+            for (size_t offset = 1; offset < m_queues.size(); ++offset) {
+                Queue                      &victim = *m_queues[(self + offset) % m_queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    task = victim.tasks.front();
+                    victim.tasks.pop_front();
+                    m_pending.fetch_sub(1);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * 执行一个任务，异常记录到所属的Job而不向外传播：
+         * 工作线程上抛出会终止进程，调用线程上抛出则会在其他线程仍持有任务时销毁栈上的Job
+         */
+        static void run(const Task &task)
+        {
+            Job &job = *task.job;
+            if (!job.failed.load(std::memory_order_relaxed)) {
+                try {
+                    (*job.fn)(task.index);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(job.errorMutex);
+                    if (!job.error) {
+                        job.error = std::current_exception();
+                    }
+                    job.failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            job.remaining.fetch_sub(1, std::memory_order_release);
+        }
+
+        void workerLoop(size_t index)
+        {
+            currentPool()  = this;
+            currentIndex() = index;
+
+            while (true) {
+                Task task;
+                if (take(index, task)) {
+                    run(task);
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_sleepMutex);
+                m_wake.wait(lock, [this]() { return m_stop || m_pending.load() > 0; });
+                if (m_stop) {
+                    return;
+                }
+            }
+        }
+};
+
+}    // namespace algorithm
+}    // namespace rtd
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "job_scheduler.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 派工计划发布器
+ * 把最新的派工方案按设备建立索引写入共享内存文件，供rtd_server直接查询"下一批次"
+ */
+class DispatchPlanPublisher {
+    public:
+        /**
+         * @param path 共享内存文件路径，应位于tmpfs上（如/dev/shm）
+         */
+        explicit DispatchPlanPublisher(const std::string &path);
+
+        /**
+         * 发布派工方案
+         * @param schedule 派工方案
+         * @param machineIds 机台ID列表（没有派工的机台也会写入空队列）
+         * @param releaseTime 方案发布时间
+         * @return 是否发布成功
+         */
+        bool publish(const Schedule &schedule, const std::vector<std::string> &machineIds, double releaseTime);
+
+        const std::string &getPath() const { return m_path; }
+
+    private:
+        std::string m_path;
+        uint64_t    m_sequence;
+
+        // 将旧快照标记为已替换
+        void markSuperseded(int fd);
+};
+
+}    // namespace schedule
+}    // namespace rtd
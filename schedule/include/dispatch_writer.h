@@ -0,0 +1,72 @@
+#pragma once
+
+#include "schedule_data_manager.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 调度结果后台写入器
+ * 调度循环把每一版方案提交到有界队列后立即返回，由写入线程调用saveDispatchDiff（差量写入）
+ * 或saveDispatchResults（全量插入）写入数据库。
+ * 队列已满时丢弃最早未写入的方案：差量写入总是与已发布的计划比较，全量插入以最新一版为准，跳过被更新版本覆盖的中间方案不影响最终结果。
+ * 容量为0时不启动写入线程，submit在调用线程上同步写入
+ */
+class DispatchWriter {
+    public:
+        using Results = std::vector<std::tuple<std::string, std::string, double, double, double>>;
+
+        /**
+         * @param dataManager 数据管理器，写入线程与调度循环共用，须比写入器存活更久
+         * @param queueCapacity 最多排队的方案数，0表示同步写入
+         * @param diff 是否差量写入
+         */
+        DispatchWriter(ScheduleDataManager &dataManager, size_t queueCapacity, bool diff);
+        ~DispatchWriter();
+
+        // 启动写入线程
+        void start();
+
+        // 写完队列中剩余的方案后停止写入线程
+        void stop();
+
+        /**
+         * 提交一版调度方案
+         * @param results 完整的新计划
+         * @param releaseTime 发布时间
+         */
+        void submit(Results results, double releaseTime);
+
+    private:
+        struct Job {
+                Results results;
+                double  releaseTime = 0.0;
+        };
+
+        ScheduleDataManager &m_dataManager;
+        size_t               m_capacity;
+        bool                 m_diff;
+
+        std::deque<Job>         m_queue;
+        std::mutex              m_mutex;
+        std::condition_variable m_cv;
+        bool                    m_stopping = false;
+        std::thread             m_thread;
+
+        // 写入线程主循环
+        void run();
+
+        // 写入一版方案
+        void write(const Job &job);
+};
+
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "migration_transport.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 分布式岛屿协调进程
+ * 监听TCP端口接收工作进程，每次求解时广播问题，按进程环路由移民，并汇总全局最优解
+ * 协调进程自身也运行本地岛屿，是进程环中的第0个节点
+ */
+class IslandCoordinator: public MigrationTransport {
+    public:
+        /**
+         * @param port 监听端口
+         * @param timeoutSeconds 等待工作进程消息的超时时间，超时的工作进程被移出本次求解
+         */
+        IslandCoordinator(int port, int timeoutSeconds);
+        ~IslandCoordinator() override;
+
+        // 开始监听
+        bool start();
+
+        // 停止监听并通知所有工作进程退出
+        void stop();
+
+        // 当前已连接的工作进程数量
+        size_t getWorkerCount();
+
+        // MigrationTransport接口实现
+        void                    beginRun(const DistributedRunSpec &spec) override;
+        std::vector<Chromosome> exchangeMigrants(const std::vector<Chromosome> &emigrants) override;
+        std::vector<Chromosome> finishRun(const Chromosome &localBest, double localBestFitness) override;
+
+    private:
+        int               m_port;
+        int               m_timeoutSeconds;
+        int               m_listenFd;
+        std::atomic<bool> m_running;
+        std::thread       m_acceptThread;
+
+        std::mutex       m_mutex;
+        std::vector<int> m_pendingWorkers;    // 已连接、等待下一次求解的工作进程
+        std::vector<int> m_activeWorkers;     // 参与当前求解的工作进程
+
+        // 接受连接的线程
+        void acceptLoop();
+
+        // 移除失效的工作进程
+        void dropWorker(size_t index);
+};
+
+/**
+ * 分布式岛屿工作进程
+ * 连接协调进程，接收问题后运行本地岛屿，并在每个迁移周期与协调进程交换移民
+ */
+class IslandWorker {
+    public:
+        IslandWorker(const std::string &host, int port, int timeoutSeconds);
+
+        /**
+         * 运行工作循环，直到收到退出指令或running为false
+         * @return 进程退出码
+         */
+        int run(const std::atomic<bool> &running);
+
+    private:
+        std::string m_host;
+        int         m_port;
+        int         m_timeoutSeconds;
+
+        // 连接协调进程
+        int connectToCoordinator();
+
+        // 处理一次求解
+        void solve(int fd, const std::vector<char> &payload);
+};
+
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "schedule_chromosome.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 遗传算法检查点
+ * 保存各岛种群、适应度、随机数状态、最优个体以及问题指纹，用于重启后快速恢复
+ *
+ * 文件为定长段组成的二进制格式，可直接mmap读取:
+ *   Header | 批次ID长度(u32[]) | 批次ID | 机台ID长度(u32[]) | 机台ID
+ *          | 个体基因数(u32[island*pop]) | 基因(u32[island*pop*stride])
+ *          | 适应度(f64[island*pop]) | 随机数状态(u32[island*625]) | 最优个体(u32[])
+ */
+struct GACheckpoint {
+        uint64_t                             fingerprint = 0;
+        size_t                               generation  = 0;
+        std::vector<std::string>             lotIds;
+        std::vector<std::string>             machineIds;
+        std::vector<std::vector<Chromosome>> populations;
+        std::vector<std::vector<double>>     fitness;
+        std::vector<std::mt19937>            rngs;
+        Chromosome                           bestChromosome;
+        double                               bestFitness = 0.0;
+
+        /**
+         * 写入检查点（先写临时文件再原子替换）
+         * @return 是否成功
+         */
+        bool write(const std::string &path) const;
+
+        /**
+         * 读取检查点
+         * @return 是否成功（文件不存在或格式无效时返回false）
+         */
+        bool read(const std::string &path);
+
+        /**
+         * 计算问题指纹
+         * 批次、机台或任一处理时间变化都会改变指纹
+         */
+        static uint64_t fingerprintOf(
+          const std::vector<std::string>         &lotIds,
+          const std::vector<std::string>         &machineIds,
+          const std::vector<std::vector<double>> &processingTimes);
+};
+
+}    // namespace schedule
+}    // namespace rtd
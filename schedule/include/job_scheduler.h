@@ -1,6 +1,8 @@
 #pragma once
 
+#include <functional>
 #include <future>
+#include "schedule_telemetry.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -8,6 +10,8 @@
 namespace rtd {
 namespace schedule {
 
+class MigrationTransport;
+
 /**
  * 派工结果项
  * 表示一个批次在特定机台上的调度
@@ -59,6 +63,38 @@ struct Schedule {
         }
 };
 
+/**
+ * 求解进度
+ * 初始化完成及每代结束时报告一次，用于记录最优完工时间随耗时和评估次数变化的曲线
+ */
+struct SearchProgress {
+        size_t generation;        // 已完成代数（0表示初始种群）
+        size_t evaluations;       // 累计适应度评估次数
+        double bestMakespan;      // 当前最优完工时间
+        double elapsedSeconds;    // 自求解开始的耗时
+};
+
+using ProgressCallback = std::function<void(const SearchProgress &)>;
+
+/**
+ * 染色体编码
+ */
+enum class ChromosomeEncoding {
+    PERMUTATION,    // 基因为 批次 * 机台数 + 机台 的排列，机台分配随交叉和修复间接变化
+    TWO_PART        // 机台分配向量加批次加工顺序，两段分别交叉和变异，直接在分配上搜索
+};
+
+/**
+ * 解析染色体编码名称（permutation / two_part）
+ * @return 名称是否有效
+ */
+bool parseChromosomeEncoding(const std::string &name, ChromosomeEncoding &encoding);
+
+/**
+ * 染色体编码名称
+ */
+const char *chromosomeEncodingName(ChromosomeEncoding encoding);
+
 /**
  * 派工调度器接口
  * 用于计算最优派工方案
@@ -93,6 +129,32 @@ class JobScheduler {
          */
         virtual bool setProcessingTime(size_t lotIndex, size_t machineIndex, double time) = 0;
 
+        /**
+         * 设置初始派工方案，用于事件触发的增量重调度
+         * 方案中仍然有效的分配按原顺序保留，新增或失效的批次按最早完工贪心插入，
+         * 修复后的方案作为种群的初始个体，只需少量代数即可收敛
+         * @param schedule 上一次发布的派工方案（按批次ID和机台ID匹配）
+         */
+        virtual void setInitialSchedule(const Schedule &schedule) = 0;
+
+        /**
+         * 设置进程间迁移通道
+         * 设置后每个迁移周期除本地岛屿间迁移外，还与其他rtd_schedule进程交换移民，
+         * 求解结束时返回所有进程中的全局最优解
+         */
+        virtual void setMigrationTransport(std::shared_ptr<MigrationTransport> transport) = 0;
+
+        /**
+         * 设置遗传算法检查点
+         * 求解过程中每隔interval代及结束时把种群状态写入path；restore为true时，求解开始时若path存在可用检查点，
+         * 问题完全一致则原样恢复种群和随机数状态，批次部分重叠则按ID重映射后作为初始种群。
+         * 只应在进程启动后的第一次全量求解时恢复，之后的全量求解会各自覆盖检查点
+         * @param path 检查点文件路径，为空时不启用
+         * @param interval 写入间隔（代数），为0时只在结束时写入
+         * @param restore 求解开始时是否从检查点恢复
+         */
+        virtual void setCheckpoint(const std::string &path, size_t interval, bool restore) = 0;
+
         /**
          * 计算最优派工方案
          * @return 派工方案
@@ -115,6 +177,48 @@ class JobScheduler {
         virtual void setMigrationInterval(size_t interval)  = 0;
         virtual void setMigrationRate(double rate)          = 0;
 
+        /**
+         * 固定随机数种子，使相同输入得到可复现的结果（默认使用时间种子）
+         */
+        virtual void setRandomSeed(unsigned seed) = 0;
+
+        /**
+         * 设置演化线程数，为0时每个岛一个线程（默认）
+         * 每个岛使用独立的随机数生成器，固定种子时结果与线程数无关
+         */
+        virtual void setThreadCount(size_t threads) = 0;
+
+        /**
+         * 设置岛内子代分块大小（默认0，每个岛在一个线程内演化）
+         * 非0时岛和岛内的子代分块共享一个工作窃取线程池，线程数为0时取硬件线程数，
+         * 岛数少于核数时也能用满机器；每块使用由岛派生的随机数生成器，固定种子时结果与线程数无关
+         */
+        virtual void setOffspringChunkSize(size_t chunk) = 0;
+
+        /**
+         * 设置是否把演化线程绑定到CPU（默认否，仅Linux有效）
+         * 岛按NUMA节点分组放置，种群分配在所在节点，多节点时处理时间矩阵在每个节点复制一份；
+         * 单节点机器只绑定CPU，检测不到CPU信息时不绑定
+         */
+        virtual void setThreadAffinity(bool enabled) = 0;
+
+        /**
+         * 设置染色体编码（默认PERMUTATION）
+         * 检查点、增量重调度的种子和进程间迁移在两种编码之间自动转换
+         */
+        virtual void setEncoding(ChromosomeEncoding encoding) = 0;
+
+        /**
+         * 设置求解进度回调，在求解线程中同步调用
+         */
+        virtual void setProgressCallback(ProgressCallback callback) = 0;
+
+        /**
+         * 设置每代遥测回调，在求解线程中同步调用
+         * 提供各岛适应度统计、种群多样性、评估速率和各阶段耗时；未设置时不做额外计时
+         */
+        virtual void setTelemetryCallback(TelemetryCallback callback) = 0;
+
         /**
          * 创建新的派工调度器实例
          */
@@ -1,7 +1,8 @@
 #pragma once
 
-#include "../include/algorithm/archipelago_ga.hh"    // 修改引用路径
+#include "schedule_ga_policies.h"
 #include "job_scheduler.h"
+#include "migration_transport.h"
 #include "schedule_chromosome.h"
 #include "schedule_evaluator.h"
 #include <random>
@@ -22,6 +23,9 @@ class JobSchedulerImpl: public JobScheduler {
         void                  setMachines(const std::vector<std::string> &machineIds) override;
         bool                  setProcessingTimes(const std::vector<std::vector<double>> &processingTimes) override;
         bool                  setProcessingTime(size_t lotIndex, size_t machineIndex, double time) override;
+        void                  setInitialSchedule(const Schedule &schedule) override;
+        void                  setMigrationTransport(std::shared_ptr<MigrationTransport> transport) override;
+        void                  setCheckpoint(const std::string &path, size_t interval, bool restore) override;
         Schedule              calculateSchedule() override;
         std::future<Schedule> calculateScheduleAsync() override;
 
@@ -34,6 +38,13 @@ class JobSchedulerImpl: public JobScheduler {
         void setElitismCount(size_t count) override { m_elitismCount = count; }
         void setMigrationInterval(size_t interval) override { m_migrationInterval = interval; }
         void setMigrationRate(double rate) override { m_migrationRate = rate; }
+        void setRandomSeed(unsigned seed) override { m_rng.seed(seed); }
+        void setThreadCount(size_t threads) override { m_threadCount = threads; }
+        void setOffspringChunkSize(size_t chunk) override { m_offspringChunk = chunk; }
+        void setThreadAffinity(bool enabled) override { m_pinThreads = enabled; }
+        void setEncoding(ChromosomeEncoding encoding) override { m_encoding = encoding; }
+        void setProgressCallback(ProgressCallback callback) override { m_progressCallback = std::move(callback); }
+        void setTelemetryCallback(TelemetryCallback callback) override { m_telemetryCallback = std::move(callback); }
 
     private:
         // 批次和机台信息
@@ -50,16 +61,44 @@ class JobSchedulerImpl: public JobScheduler {
         size_t m_elitismCount;
         size_t m_migrationInterval;
         double m_migrationRate;
+        size_t m_threadCount;
+        size_t m_offspringChunk;
+        bool   m_pinThreads;
+
+        // 染色体编码
+        ChromosomeEncoding m_encoding;
+
+        // 求解进度和遥测回调
+        ProgressCallback  m_progressCallback;
+        TelemetryCallback m_telemetryCallback;
+
+        // 增量重调度的初始方案
+        Schedule m_initialSchedule;
+        bool     m_hasInitialSchedule;
+
+        // 进程间迁移通道
+        std::shared_ptr<MigrationTransport> m_transport;
+
+        // 检查点
+        std::string m_checkpointPath;
+        size_t      m_checkpointInterval;
+        bool        m_checkpointRestore;
 
         // 随机数生成
         std::mt19937 m_rng;
 
         // 实用方法
-        Schedule decodeChromosome(const Chromosome &chromosome);
-        bool     isValidProblem() const;
-        void     validateInputs();
+        Schedule   decodeChromosome(const Chromosome &chromosome);
+        Chromosome buildSeedChromosome() const;
+        bool       isValidProblem() const;
+        void       validateInputs();
+
+        // 按染色体编码求解
+        template<typename Genotype>
+        Schedule solve();
 
         // 多岛遗传算法实现
+        template<typename Genotype>
         class SchedulerGA;
 };
 
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+namespace layout {
+
+/**
+ * 可直接mmap读取的二进制文件共用的布局工具
+ * 各段按8字节对齐，ID列表存为 长度(u32[count]) | 字符（不含结尾符）
+ */
+
+// 按8字节对齐，保证各段可以直接按类型访问
+inline size_t align8(size_t offset)
+{
+    return (offset + 7) & ~static_cast<size_t>(7);
+}
+
+/**
+ * 检查[offset, offset + count * elementSize)在limit以内，乘法和加法溢出时也返回false
+ */
+inline bool sectionFits(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t limit)
+{
+    if (offset > limit) {
+        return false;
+    }
+    return elementSize == 0 || count <= (limit - offset) / elementSize;
+}
+
+// 段起点按8字节对齐
+inline bool isAligned8(uint64_t offset)
+{
+    return (offset & 7) == 0;
+}
+
+// ID列表段的字节数
+inline size_t idSectionSize(const std::vector<std::string> &ids)
+{
+    size_t size = ids.size() * sizeof(uint32_t);
+    for (const auto &id: ids) {
+        size += id.size();
+    }
+    return size;
+}
+
+// 写入ID列表段，返回段尾
+inline char *writeIds(char *dest, const std::vector<std::string> &ids)
+{
+    auto *lengths = reinterpret_cast<uint32_t *>(dest);
+    char *chars   = dest + ids.size() * sizeof(uint32_t);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        lengths[i] = static_cast<uint32_t>(ids[i].size());
+        std::memcpy(chars, ids[i].data(), ids[i].size());
+        chars += ids[i].size();
+    }
+    return chars;
+}
+
+/**
+ * 读取ID列表段
+ * @param limit 段不能越过的偏移（下一段起点或文件大小）
+ * @return 段完整且未越界时返回true
+ */
+inline bool readIds(const char *base, size_t offset, size_t count, size_t limit, std::vector<std::string> &ids)
+{
+    if (!sectionFits(offset, count, sizeof(uint32_t), limit)) {
+        return false;
+    }
+
+    const auto *lengths  = reinterpret_cast<const uint32_t *>(base + offset);
+    size_t      position = offset + count * sizeof(uint32_t);
+
+    ids.clear();
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (lengths[i] > limit - position) {
+            return false;
+        }
+        ids.emplace_back(base + position, lengths[i]);
+        position += lengths[i];
+    }
+    return true;
+}
+
+}    // namespace layout
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "job_scheduler.h"
+#include "schedule_chromosome.h"
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 分布式运行参数
+ * 由协调进程广播给所有工作进程，保证各进程求解同一个问题
+ */
+struct DistributedRunSpec {
+        size_t                                  islandCount;
+        size_t                                  populationPerIsland;
+        size_t                                  generationCount;
+        size_t                                  migrationInterval;
+        double                                  migrationRate;
+        double                                  crossoverRate;
+        double                                  mutationRate;
+        size_t                                  elitismCount;
+        size_t                                  lotCount;
+        size_t                                  machineCount;
+        const std::vector<std::vector<double>> *processingTimes;
+        ChromosomeEncoding                      encoding;
+};
+
+/**
+ * 进程间迁移通道
+ * 让多岛遗传算法的岛屿分布在多个进程中，每个迁移周期与其他进程交换移民
+ */
+class MigrationTransport {
+    public:
+        virtual ~MigrationTransport() = default;
+
+        /**
+         * 开始一次求解
+         */
+        virtual void beginRun(const DistributedRunSpec &spec) = 0;
+
+        /**
+         * 交换移民
+         * 所有进程在相同的迁移周期调用，提交本进程的移民并返回其他进程发来的移民
+         * @param emigrants 本进程的移民
+         * @return 收到的移民
+         */
+        virtual std::vector<Chromosome> exchangeMigrants(const std::vector<Chromosome> &emigrants) = 0;
+
+        /**
+         * 结束一次求解并汇总各进程的最优个体
+         * 返回的个体未经修复，调用方需按移民的方式修复并在本地重新评估后再比较
+         * @param localBest 本进程的最优个体
+         * @param localBestFitness 本进程最优个体的适应度
+         * @return 其他进程上报的最优个体
+         */
+        virtual std::vector<Chromosome> finishRun(const Chromosome &localBest, double localBestFitness) = 0;
+};
+
+}    // namespace schedule
+}    // namespace rtd
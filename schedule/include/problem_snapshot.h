@@ -0,0 +1,37 @@
+#pragma once
+
+#include "schedule_data_manager.h"
+#include <string>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 调度问题快照文件
+ * 保存一轮调度的输入（设备、批次和稀疏处理时间），用于离线回放和性能测试，不需要数据库
+ *
+ * 文件为定长段组成的二进制格式，可直接mmap读取:
+ *   Header | 设备ID长度(u32[]) | 设备ID | 批次ID长度(u32[]) | 批次ID
+ *          | 每个批次的配对起点(u64[lot+1]) | 设备下标(u32[pairs]) | 处理时间(f64[pairs])
+ * 只保存大于0的处理时间，按批次行压缩存储
+ */
+
+/**
+ * 写入快照（先写临时文件再原子替换）
+ * @return 是否成功
+ */
+bool writeProblemSnapshot(const std::string &path, const MasterDataSnapshot &snapshot);
+
+/**
+ * 读取快照并展开为稠密处理时间矩阵
+ * @return 是否成功（文件不存在或格式无效时返回false）
+ */
+bool readProblemSnapshot(const std::string &path, MasterDataSnapshot &snapshot);
+
+/**
+ * 文件是否为问题快照（只检查文件头）
+ */
+bool isProblemSnapshotFile(const std::string &path);
+
+}    // namespace schedule
+}    // namespace rtd
@@ -8,6 +8,45 @@
 namespace rtd {
 namespace schedule {
 
+/**
+ * 批次的可加工机台表
+ * 由处理时间矩阵一次性构建（处理时间大于零即可加工），供随机生成、修复和变异直接查表，
+ * 避免每次遍历全部机台
+ */
+class EligibilityTable {
+    public:
+        EligibilityTable() = default;
+
+        EligibilityTable(
+          size_t                                  lotCount,
+          size_t                                  machineCount,
+          const std::vector<std::vector<double>> &processingTimes);
+
+        size_t lotCount() const { return m_machines.size(); }
+        size_t machineCount() const { return m_machineCount; }
+
+        /**
+         * 批次的可加工机台（按机台下标升序）
+         */
+        const std::vector<size_t> &machines(size_t lot) const
+        {
+            return m_machines[lot];
+        }
+
+        /**
+         * 批次能否在机台上加工
+         */
+        bool isEligible(size_t lot, size_t machine) const
+        {
+            return m_eligible[lot * m_machineCount + machine];
+        }
+
+    private:
+        size_t                           m_machineCount = 0;
+        std::vector<std::vector<size_t>> m_machines;
+        std::vector<bool>                m_eligible;
+};
+
 /**
  * 代表一个派工方案编码的染色体
  */
@@ -82,6 +121,11 @@ class Chromosome {
           const std::vector<std::vector<double>> &processingTimes,
           std::mt19937                           &generator);
 
+        /**
+         * 按可加工机台表创建随机染色体
+         */
+        static Chromosome createRandom(const EligibilityTable &eligibility, std::mt19937 &generator);
+
         /**
          * 交叉操作 - 使用顺序交叉(OX)
          * @param other 另一个父染色体
@@ -99,6 +143,32 @@ class Chromosome {
          */
         void mutate(double mutationRate, std::mt19937 &generator);
 
+        /**
+         * 按批次的顺序交叉
+         * 以批次而非基因判断重复，每个批次恰好出现一次并沿用其来源父代的机台，
+         * 父代可行时子代必然可行，无需修复
+         * @param other 另一个父染色体（须与本染色体包含相同的批次）
+         * @param eligibility 可加工机台表
+         * @param generator 随机数生成器
+         * @return 子代染色体
+         */
+        Chromosome crossoverByLot(
+          const Chromosome       &other,
+          const EligibilityTable &eligibility,
+          std::mt19937           &generator) const;
+
+        /**
+         * 变异操作 - 机台重分配
+         * 每个批次以给定概率改派到另一台可加工机台，不改变顺序，保持可行性
+         * @param mutationRate 变异率
+         * @param eligibility 可加工机台表
+         * @param generator 随机数生成器
+         */
+        void mutateAssignment(
+          double                  mutationRate,
+          const EligibilityTable &eligibility,
+          std::mt19937           &generator);
+
         /**
          * 检查染色体是否有效
          * @param lotCount 批次数量
@@ -124,6 +194,14 @@ class Chromosome {
           const std::vector<std::vector<double>> &processingTimes,
           std::mt19937                           &generator);
 
+        /**
+         * 按可加工机台表修复无效染色体，线性时间
+         * 无效位置依次改填缺失批次，多余的无效位置一次性压缩删除，仍缺失的批次追加到末尾
+         * @param eligibility 可加工机台表
+         * @param generator 随机数生成器
+         */
+        void repair(const EligibilityTable &eligibility, std::mt19937 &generator);
+
     private:
         std::vector<size_t> m_genes;
 };
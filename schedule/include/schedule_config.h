@@ -0,0 +1,105 @@
+#pragma once
+
+#include "dispatch_plan_layout.h"
+#include "job_scheduler.h"
+#include "schedule_data_manager.h"
+#include <cstddef>
+#include <string>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 调度引擎运行配置
+ * 对应config/schedule.json，缺失的项使用默认值
+ */
+struct ScheduleConfig {
+        // 内存派工计划发布
+        struct DispatchPlanConfig {
+                bool        enabled = true;
+                std::string path    = dispatch::kDefaultPlanPath;
+        };
+
+        // 事件驱动的增量重调度
+        struct EventConfig {
+                bool        enabled           = true;
+                std::string socketPath        = "/tmp/rtd_schedule_events.sock";
+                int         debounceMs        = 200;    // 合并突发事件的等待时间
+                size_t      refineGenerations = 30;     // 增量修复后的GA细化代数
+        };
+
+        // 多进程分布式岛屿（本进程作为协调进程）
+        struct DistributedConfig {
+                bool enabled        = false;
+                int  listenPort     = 7600;
+                int  timeoutSeconds = 60;    // 等待工作进程消息的超时时间
+        };
+
+        // 遗传算法检查点，重启后从检查点恢复种群
+        struct CheckpointConfig {
+                bool        enabled             = true;
+                std::string path                = "./rtd_schedule.ckpt";
+                size_t      intervalGenerations = 20;    // 写入间隔（代数）
+        };
+
+        // 每代遥测，以JSON Lines格式追加写入
+        struct TelemetryConfig {
+                bool        enabled = false;
+                std::string path    = "./ga_telemetry.jsonl";
+        };
+
+        // 主数据快照，未配置增量查询时每轮全量加载
+        struct SnapshotConfig {
+                size_t      fullReloadCycles = 10;    // 每隔多少轮强制全量加载（清理硬删除和漏掉的变更），0表示不强制
+                std::string recordPath;               // 非空时把每轮全量调度的输入录制为问题快照文件
+                std::string replayPath;               // 非空时从问题快照文件读取主数据，不连接数据库
+        };
+
+        // 调度结果写入
+        // diff为true时只写入与已发布计划相比变化的批次，需要dispatch表lot_id唯一和dispatch_release表，
+        // 启用前先执行common/sql/postgresql/migrate_dispatch_diff.sql；默认每轮全量插入
+        struct DispatchWriteConfig {
+                size_t batchSize = kDefaultDispatchBatchSize;    // 每次数组绑定插入的行数
+                bool   diff      = false;                        // 是否差量写入
+        };
+
+        // 调度周期流水线：下一轮主数据预取与求解重叠，结果由后台线程写入
+        struct PipelineConfig {
+                bool   enabled    = true;
+                size_t writeQueue = 2;    // 等待写入的方案数上限，满时丢弃最早的方案
+        };
+
+        // 遗传算法
+        struct GAConfig {
+                ChromosomeEncoding encoding       = ChromosomeEncoding::PERMUTATION;
+                size_t             threads        = 0;        // 演化线程数，0为默认
+                size_t             offspringChunk = 0;        // 岛内子代分块大小，0表示不在岛内并行
+                bool               pinThreads     = false;    // 演化线程绑定CPU并按NUMA节点放置
+        };
+
+        // 插桩探针输出（需以RTD_SCHEDULE_PROFILE编译）
+        struct ProfileConfig {
+                std::string tracePath = "./rtd_schedule_trace.json";    // 每轮调度结束时覆盖写入
+        };
+
+        DispatchPlanConfig  dispatchPlan;
+        EventConfig         events;
+        DistributedConfig   distributed;
+        CheckpointConfig    checkpoint;
+        TelemetryConfig     telemetry;
+        SnapshotConfig      snapshot;
+        DispatchWriteConfig dispatchWrite;
+        PipelineConfig      pipeline;
+        GAConfig            ga;
+        ProfileConfig       profile;
+
+        /**
+         * 加载配置文件
+         * @param filePath 配置文件路径
+         * @return 配置（文件不存在时返回默认配置）
+         */
+        static ScheduleConfig load(const std::string &filePath = "./config/schedule.json");
+};
+
+}    // namespace schedule
+}    // namespace rtd
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <future>
 #include <map>
 #include <memory>
@@ -9,6 +10,27 @@
 namespace rtd {
 namespace schedule {
 
+// 批量保存调度结果时每次执行插入的默认行数
+constexpr size_t kDefaultDispatchBatchSize = 1000;
+
+/**
+ * 批次与可加工设备的关系
+ */
+struct LotEligibility {
+        std::vector<std::string>         lots;          // 去重后的批次ID，按ID排序
+        std::vector<std::vector<size_t>> equipments;    // 每个批次可加工设备在设备列表中的下标
+};
+
+/**
+ * 主数据快照：设备、批次和处理时间矩阵（行为批次，列为设备）
+ */
+struct MasterDataSnapshot {
+        std::vector<std::string>         equipments;
+        std::vector<std::string>         lots;
+        std::vector<std::vector<double>> processingTimes;
+        long long                        version = 0;    // 已应用的最大数据版本号
+};
+
 /**
  * 调度数据管理器
  * 处理设备、批次和处理时间的数据访问
@@ -16,6 +38,9 @@ namespace schedule {
 class ScheduleDataManager {
     public:
         static std::unique_ptr<ScheduleDataManager> create();
+
+        // 从问题快照文件读取主数据（离线回放、性能测试），调度结果写入快照旁的CSV文件
+        static std::unique_ptr<ScheduleDataManager> createFromSnapshot(const std::string &snapshotPath);
         virtual ~ScheduleDataManager() = default;
 
         // 初始化数据管理器
@@ -30,14 +55,38 @@ class ScheduleDataManager {
         // 获取所有批次ID
         virtual std::vector<std::string> getAllLots() = 0;
 
+        // 一次获取所有批次及其可加工设备（只保留equipments中的设备）
+        virtual LotEligibility getLotEligibility(const std::vector<std::string> &equipments) = 0;
+
         // 获取特定设备和批次的处理时间
         virtual double getProcessTime(const std::string &equipmentId, const std::string &lotId) = 0;
 
-        // 获取处理时间矩阵
+        /**
+         * 获取一个批次在equipments中各设备上的处理时间，只返回大于0的
+         * 配置了getProcessTimeByLot集合查询时一次取回，否则逐台设备查询。查询失败时返回空结果，
+         * 且不计入全量加载的查询失败次数：事件处理与预取线程上的全量加载并发进行
+         */
+        virtual std::map<std::string, double> getProcessTimesByLot(
+          const std::string              &lotId,
+          const std::vector<std::string> &equipments) = 0;
+
+        // 获取处理时间矩阵：配置了getProcessTimeMatrix集合查询时一次取回，否则逐对调用getProcessTime
         virtual std::vector<std::vector<double>> getProcessTimeMatrix(
           const std::vector<std::string> &lots,
           const std::vector<std::string> &equipments) = 0;
 
+        // 获取处理时间矩阵，逐对查询时只查询eligibility中的可加工配对
+        virtual std::vector<std::vector<double>> getProcessTimeMatrix(
+          const LotEligibility           &eligibility,
+          const std::vector<std::string> &equipments) = 0;
+
+        /**
+         * 刷新并返回缓存的主数据快照
+         * 首次调用、fullReload或未配置增量查询时全量加载；否则只查询版本号大于上次的变更行，应用到缓存后重建快照。
+         * 增量查询失败时退回全量加载
+         */
+        virtual const MasterDataSnapshot &refreshSnapshot(bool fullReload = false) = 0;
+
         // 保存调度结果
         virtual bool saveDispatchResult(
           const std::string &equipmentId,
@@ -46,9 +95,29 @@ class ScheduleDataManager {
           double             startTime,
           double             endTime) = 0;
 
-        // 批量保存调度结果
+        /**
+         * 批量保存调度结果
+         * 按数组绑定每次插入一批，整个结果在一个事务内写入，任何一批失败则全部回滚
+         * @return 是否全部写入
+         */
         virtual bool saveDispatchResults(
           const std::vector<std::tuple<std::string, std::string, double, double, double>> &results) = 0;
+
+        /**
+         * 差量保存调度结果
+         * 按批次与上次发布的计划比较，只删除、更新、插入设备或开始、结束时间有变化的派工记录，
+         * 并写入一条记录版本号和变化行数的发布头。重启后第一次调用时先从数据库读取已发布的计划。
+         * 所有写入在一个事务内，失败时全部回滚；未配置差量写入所需的查询时退回saveDispatchResults
+         * @param results 完整的新计划，每个批次一条
+         * @param releaseTime 发布时间，写入新增和变化的记录以及发布头
+         * @return 是否写入成功
+         */
+        virtual bool saveDispatchDiff(
+          const std::vector<std::tuple<std::string, std::string, double, double, double>> &results,
+          double                                                                           releaseTime) = 0;
+
+        // 设置批量保存时每批插入的行数
+        virtual void setDispatchBatchSize(size_t batchSize) = 0;
 };
 
 }    // namespace schedule
@@ -2,6 +2,7 @@
 
 #include "job_scheduler.h"
 #include "schedule_chromosome.h"
+#include "schedule_two_part_chromosome.h"
 
 namespace rtd {
 namespace schedule {
@@ -29,6 +30,14 @@ class ScheduleEvaluator {
          */
         double evaluate(const Chromosome &chromosome) const;
 
+        /**
+         * 评估两段式染色体并返回适应度
+         * 完工时间只取决于各机台的负荷，直接按机台分配累加，无需解码加工顺序
+         * @param chromosome 待评估的染色体
+         * @return 适应度值(越大越好)
+         */
+        double evaluate(const TwoPartChromosome &chromosome) const;
+
         /**
          * 评估染色体并更新派工方案
          * @param chromosome 待评估的染色体
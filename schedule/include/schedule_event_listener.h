@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 调度事件类型
+ */
+enum class ScheduleEventType {
+    LOT_ARRIVED,             // 新批次到达
+    LOT_FINISHED,            // 批次完成
+    EQUIPMENT_DOWN,          // 设备停机
+    EQUIPMENT_UP,            // 设备恢复
+    PROCESS_TIME_CHANGED     // 处理时间变更
+};
+
+/**
+ * 调度事件
+ */
+struct ScheduleEvent {
+        ScheduleEventType             type;
+        std::string                   lotId;
+        std::string                   equipmentId;
+        double                        processTime = 0.0;    // PROCESS_TIME_CHANGED使用
+        std::map<std::string, double> processTimes;         // LOT_ARRIVED可携带各设备处理时间
+};
+
+/**
+ * 调度事件监听器
+ * 在本地Unix域套接字上接收JSON行格式的事件，例如:
+ *   {"type":"lot_arrived","lot_id":"LOT001","process_times":{"EQP001":35.0}}
+ *   {"type":"lot_finished","lot_id":"LOT001"}
+ *   {"type":"equipment_down","eqp_id":"EQP001"}
+ *   {"type":"equipment_up","eqp_id":"EQP001"}
+ *   {"type":"process_time_changed","lot_id":"LOT001","eqp_id":"EQP001","process_time":40.0}
+ * 每行事件回复一行 {"status":"ok"} 或 {"error":"..."}
+ */
+class ScheduleEventListener {
+    public:
+        /**
+         * @param socketPath Unix域套接字路径
+         * @param debounce 收到第一个事件后继续合并突发事件的时间
+         */
+        ScheduleEventListener(const std::string &socketPath, std::chrono::milliseconds debounce);
+        ~ScheduleEventListener();
+
+        // 开始监听
+        bool start();
+
+        // 停止监听
+        void stop();
+
+        /**
+         * 等待事件
+         * 在截止时间前阻塞，收到事件后再合并debounce时间内到达的事件一并返回
+         * @param deadline 截止时间
+         * @param running 运行标志，为false时立即返回
+         * @return 收到的事件（超时返回空）
+         */
+        std::vector<ScheduleEvent> waitForEvents(
+          std::chrono::steady_clock::time_point deadline,
+          const std::atomic<bool>              &running);
+
+        /**
+         * 解析一行JSON事件
+         * @throws std::invalid_argument 格式错误
+         */
+        static ScheduleEvent parseEvent(const std::string &line);
+
+    private:
+        std::string               m_socketPath;
+        std::chrono::milliseconds m_debounce;
+        int                       m_listenFd;
+        std::atomic<bool>         m_running;
+        std::thread               m_thread;
+
+        std::deque<ScheduleEvent> m_events;
+        std::mutex                m_mutex;
+        std::condition_variable   m_cv;
+
+        // 监听线程主循环
+        void run();
+
+        // 处理一行事件并返回应答
+        std::string handleLine(const std::string &line);
+};
+
+}    // namespace schedule
+}    // namespace rtd
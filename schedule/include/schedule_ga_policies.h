@@ -0,0 +1,160 @@
+#pragma once
+
+#include "algorithm/policy_archipelago.hh"
+#include "schedule_chromosome.h"
+#include "schedule_two_part_chromosome.h"
+#include <random>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 派工染色体的遗传操作策略，供algorithm::PolicyArchipelago使用
+ * 适应度评估直接使用ScheduleEvaluator
+ *
+ * 交叉和变异都保持可行性：可行父代产生的子代中每个批次恰好出现一次且分配在可加工机台上，
+ * 修复只是兜底的线性检查。各策略都由可加工机台表构造
+ */
+
+// 按批次的顺序交叉(OX)
+struct LotOrderCrossover {
+        const EligibilityTable *eligibility;
+
+        Chromosome cross(const Chromosome &first, const Chromosome &second, std::mt19937 &rng) const
+        {
+            return first.crossoverByLot(second, *eligibility, rng);
+        }
+};
+
+/**
+ * 交换变异加机台重分配
+ * 交换只改变加工顺序，机台分配的探索由重分配完成，其变异率为交换变异率乘以assignmentShare
+ */
+struct SwapAssignmentMutation {
+        const EligibilityTable *eligibility;
+        double                  assignmentShare = 0.02;
+
+        void mutate(Chromosome &chromosome, double rate, std::mt19937 &rng) const
+        {
+            chromosome.mutate(rate, rng);
+            chromosome.mutateAssignment(rate * assignmentShare, *eligibility, rng);
+        }
+};
+
+// 修复为每个批次恰好分配一台可加工机台
+struct ChromosomeRepair {
+        const EligibilityTable *eligibility;
+
+        void repair(Chromosome &chromosome, std::mt19937 &rng) const
+        {
+            chromosome.repair(*eligibility, rng);
+        }
+};
+
+// 两段式染色体：机台分配均匀交叉，加工顺序OX
+struct TwoPartCrossover {
+        const EligibilityTable *eligibility;
+
+        TwoPartChromosome cross(const TwoPartChromosome &first, const TwoPartChromosome &second, std::mt19937 &rng) const
+        {
+            return first.crossover(second, rng);
+        }
+};
+
+/**
+ * 两段式染色体的变异
+ * 机台重分配直接决定完工时间，其变异率为给定变异率乘以assignmentShare；加工顺序按给定变异率交换
+ */
+struct TwoPartMutation {
+        const EligibilityTable *eligibility;
+        double                  assignmentShare = 0.02;
+
+        void mutate(TwoPartChromosome &chromosome, double rate, std::mt19937 &rng) const
+        {
+            chromosome.mutate(rate * assignmentShare, rate, *eligibility, rng);
+        }
+};
+
+struct TwoPartRepair {
+        const EligibilityTable *eligibility;
+
+        void repair(TwoPartChromosome &chromosome, std::mt19937 &rng) const
+        {
+            chromosome.repair(*eligibility, rng);
+        }
+};
+
+/**
+ * 各染色体编码的遗传操作和编码转换
+ * 检查点、进程间迁移和最终解码统一使用基因编码的Chromosome，其他编码在边界处转换
+ */
+template<typename Genotype>
+struct GenotypeOperators;
+
+template<>
+struct GenotypeOperators<Chromosome> {
+        using Crossover = LotOrderCrossover;
+        using Mutation  = SwapAssignmentMutation;
+        using Repair    = ChromosomeRepair;
+
+        static Chromosome createRandom(const EligibilityTable &eligibility, std::mt19937 &rng)
+        {
+            return Chromosome::createRandom(eligibility, rng);
+        }
+
+        static Chromosome fromChromosome(const Chromosome &chromosome, const EligibilityTable &eligibility, std::mt19937 &rng)
+        {
+            Chromosome result = chromosome;
+            result.repair(eligibility, rng);
+            return result;
+        }
+
+        static Chromosome toChromosome(const Chromosome &chromosome, const EligibilityTable &)
+        {
+            return chromosome;
+        }
+
+        // 每个批次的机台，未分配的批次为machineCount
+        static std::vector<size_t> assignmentOf(const Chromosome &chromosome, const EligibilityTable &eligibility)
+        {
+            const size_t        machineCount = eligibility.machineCount();
+            std::vector<size_t> assignment(eligibility.lotCount(), machineCount);
+            for (size_t gene: chromosome.getGenes()) {
+                if (gene / machineCount < assignment.size()) {
+                    assignment[gene / machineCount] = gene % machineCount;
+                }
+            }
+            return assignment;
+        }
+};
+
+template<>
+struct GenotypeOperators<TwoPartChromosome> {
+        using Crossover = TwoPartCrossover;
+        using Mutation  = TwoPartMutation;
+        using Repair    = TwoPartRepair;
+
+        static TwoPartChromosome createRandom(const EligibilityTable &eligibility, std::mt19937 &rng)
+        {
+            return TwoPartChromosome::createRandom(eligibility, rng);
+        }
+
+        static TwoPartChromosome fromChromosome(const Chromosome &chromosome, const EligibilityTable &eligibility, std::mt19937 &rng)
+        {
+            return TwoPartChromosome::fromChromosome(chromosome, eligibility, rng);
+        }
+
+        static Chromosome toChromosome(const TwoPartChromosome &chromosome, const EligibilityTable &eligibility)
+        {
+            return chromosome.toChromosome(eligibility.machineCount());
+        }
+
+        static std::vector<size_t> assignmentOf(const TwoPartChromosome &chromosome, const EligibilityTable &)
+        {
+            return chromosome.getAssignment();
+        }
+};
+
+}    // namespace schedule
+}    // namespace rtd
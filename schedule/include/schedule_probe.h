@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+/**
+ * 热点路径插桩探针
+ *
+ * 编译时定义RTD_SCHEDULE_PROFILE（CMake选项RTD_SCHEDULE_PROFILE）后启用，
+ * 未定义时RTD_PROBE_SCOPE/RTD_PROBE_COUNT展开为空，不产生任何开销。
+ *
+ * 每个线程把计时事件和计数写入自己的thread_local缓冲区，热点路径上无锁；
+ * 线程退出时缓冲区并入全局记录。汇总和导出应在求解结束、没有插桩代码运行时调用。
+ */
+#ifdef RTD_SCHEDULE_PROFILE
+#define RTD_PROBE_CONCAT_INNER(a, b) a##b
+#define RTD_PROBE_CONCAT(a, b)       RTD_PROBE_CONCAT_INNER(a, b)
+#define RTD_PROBE_SCOPE(name)        ::rtd::schedule::probe::ScopedProbe RTD_PROBE_CONCAT(rtdProbe_, __LINE__)(name)
+#define RTD_PROBE_COUNT(name, delta) ::rtd::schedule::probe::count(name, delta)
+#else
+#define RTD_PROBE_SCOPE(name)
+#define RTD_PROBE_COUNT(name, delta) \
+    do {                             \
+    } while (0)
+#endif
+
+namespace rtd {
+namespace schedule {
+namespace probe {
+
+#ifdef RTD_SCHEDULE_PROFILE
+constexpr bool kEnabled = true;
+#else
+constexpr bool kEnabled = false;
+#endif
+
+/**
+ * 单个探针的汇总统计
+ */
+struct ProbeStats {
+        uint64_t calls   = 0;    // 计时次数
+        uint64_t totalNs = 0;    // 累计耗时
+        uint64_t maxNs   = 0;    // 单次最大耗时
+        uint64_t counter = 0;    // 计数探针的累计值
+};
+
+// 自进程内首次调用以来的纳秒数
+int64_t nowNs();
+
+// 记录一次计时事件（name必须是静态字符串）
+void record(const char *name, int64_t startNs, int64_t durationNs);
+
+// 累加计数（name必须是静态字符串）
+void count(const char *name, uint64_t delta);
+
+/**
+ * 作用域计时
+ */
+class ScopedProbe {
+    public:
+        explicit ScopedProbe(const char *name)
+            : m_name(name), m_start(nowNs()) {}
+
+        ~ScopedProbe() { record(m_name, m_start, nowNs() - m_start); }
+
+        ScopedProbe(const ScopedProbe &)            = delete;
+        ScopedProbe &operator=(const ScopedProbe &) = delete;
+
+    private:
+        const char *m_name;
+        int64_t     m_start;
+};
+
+/**
+ * 汇总所有线程的统计，按探针名称合并
+ */
+std::map<std::string, ProbeStats> collect();
+
+/**
+ * 输出汇总统计表
+ */
+void printSummary(std::ostream &out);
+
+/**
+ * 导出Chrome trace-event格式JSON（可在chrome://tracing或Perfetto中打开）
+ * @return 是否写入成功
+ */
+bool exportChromeTrace(const std::string &path);
+
+/**
+ * 清空已记录的事件和统计
+ */
+void reset();
+
+}    // namespace probe
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "schedule_event_listener.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 调度问题实例
+ * 保存最近一次全量加载的批次、机台和处理时间，并支持按调度事件增量修改
+ */
+class ScheduleProblem {
+    public:
+        /**
+         * 使用全量加载的数据重置问题
+         */
+        void reset(
+          const std::vector<std::string>         &lotIds,
+          const std::vector<std::string>         &machineIds,
+          const std::vector<std::vector<double>> &processingTimes);
+
+        /**
+         * 应用一个调度事件
+         * @return 问题是否发生变化
+         */
+        bool apply(const ScheduleEvent &event);
+
+        /**
+         * 导出可调度的批次（至少有一台可用机台）及对应的有效处理时间矩阵
+         * 停机设备对应的列为0，机台顺序与getMachineIds()一致
+         */
+        void exportSchedulable(
+          std::vector<std::string>         &lotIds,
+          std::vector<std::vector<double>> &processingTimes) const;
+
+        const std::vector<std::string> &getMachineIds() const { return m_machineIds; }
+
+        size_t getLotCount() const { return m_lotIds.size(); }
+
+        bool hasLot(const std::string &lotId) const { return m_lotIndex.count(lotId) > 0; }
+
+    private:
+        std::vector<std::string>                m_lotIds;
+        std::vector<std::string>                m_machineIds;
+        std::vector<std::vector<double>>        m_processingTimes;
+        std::vector<bool>                       m_machineDown;
+        std::unordered_map<std::string, size_t> m_lotIndex;
+        std::unordered_map<std::string, size_t> m_machineIndex;
+
+        bool addLot(const std::string &lotId, const std::map<std::string, double> &processTimes);
+        bool removeLot(const std::string &lotId);
+        bool setMachineDown(const std::string &equipmentId, bool down);
+        bool setProcessTime(const std::string &lotId, const std::string &equipmentId, double time);
+};
+
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 单个岛一代结束时的种群统计
+ */
+struct IslandStats {
+        double bestFitness;
+        double meanFitness;
+        double worstFitness;
+        double diversity;    // 与岛内最优个体机台分配不同的批次比例的平均值，0表示种群已收敛
+};
+
+/**
+ * 一代中各阶段的耗时（秒）
+ * 岛内阶段为所有岛线程耗时之和，迁移在主线程中执行
+ */
+struct PhaseTimes {
+        double selection  = 0.0;
+        double crossover  = 0.0;
+        double mutation   = 0.0;
+        double repair     = 0.0;
+        double evaluation = 0.0;
+        double migration  = 0.0;
+};
+
+/**
+ * 每代遥测数据
+ */
+struct GenerationStats {
+        size_t                   generation;              // 已完成代数（0表示初始种群）
+        double                   elapsedSeconds;          // 自求解开始的耗时
+        size_t                   evaluations;             // 累计适应度评估次数
+        double                   evaluationsPerSecond;    // 本代的评估速率
+        double                   bestMakespan;            // 全局最优完工时间
+        std::vector<IslandStats> islands;
+        PhaseTimes               phases;
+};
+
+using TelemetryCallback = std::function<void(const GenerationStats &)>;
+
+/**
+ * 把每代遥测数据以JSON Lines格式追加写入文件
+ * 每次求解的第0代开始一个新的run编号，便于按求解分组
+ */
+class TelemetryJsonLinesWriter {
+    public:
+        explicit TelemetryJsonLinesWriter(const std::string &path);
+
+        // 文件是否已打开
+        bool isOpen() const { return m_file.is_open(); }
+
+        // 写入一代的遥测数据
+        void write(const GenerationStats &stats);
+
+        // 作为回调使用
+        TelemetryCallback callback();
+
+    private:
+        std::ofstream m_file;
+        std::mutex    m_mutex;
+        size_t        m_run;
+};
+
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "schedule_chromosome.h"
+#include <random>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 两段式派工染色体
+ * 机台分配段记录每个批次的机台，加工顺序段是批次的排列，两段分别交叉和变异。
+ * 无关并行机上完工时间只由机台分配决定，直接在分配段上操作比通过顺序编码间接改变分配收敛更快。
+ *
+ * 没有可加工机台的批次分配为machineCount，且不出现在加工顺序中
+ */
+class TwoPartChromosome {
+    public:
+        TwoPartChromosome() = default;
+
+        TwoPartChromosome(std::vector<size_t> assignment, std::vector<size_t> sequence)
+            : m_assignment(std::move(assignment)), m_sequence(std::move(sequence)) {}
+
+        /**
+         * 获取每个批次分配的机台
+         */
+        const std::vector<size_t> &getAssignment() const
+        {
+            return m_assignment;
+        }
+
+        /**
+         * 获取批次的加工顺序
+         */
+        const std::vector<size_t> &getSequence() const
+        {
+            return m_sequence;
+        }
+
+        /**
+         * 创建随机染色体
+         * @param eligibility 可加工机台表
+         * @param generator 随机数生成器
+         */
+        static TwoPartChromosome createRandom(const EligibilityTable &eligibility, std::mt19937 &generator);
+
+        /**
+         * 从基因编码的染色体转换，并修复为有效染色体
+         * @param chromosome 基因编码的染色体（基因为 批次 * machineCount + 机台）
+         * @param eligibility 可加工机台表
+         * @param generator 随机数生成器（仅修复时使用）
+         */
+        static TwoPartChromosome fromChromosome(
+          const Chromosome       &chromosome,
+          const EligibilityTable &eligibility,
+          std::mt19937           &generator);
+
+        /**
+         * 转换为基因编码的染色体，基因按加工顺序排列
+         */
+        Chromosome toChromosome(size_t machineCount) const;
+
+        /**
+         * 交叉操作
+         * 机台分配段均匀交叉（每个批次随机取一个父代的机台），加工顺序段按批次顺序交叉(OX)
+         * @param other 另一个父染色体（须包含相同的批次）
+         * @param generator 随机数生成器
+         * @return 子代染色体
+         */
+        TwoPartChromosome crossover(const TwoPartChromosome &other, std::mt19937 &generator) const;
+
+        /**
+         * 变异操作
+         * 每个批次以assignmentRate的概率改派到另一台可加工机台，加工顺序以sequenceRate的概率交换
+         * @param assignmentRate 机台重分配的变异率
+         * @param sequenceRate 加工顺序交换的变异率
+         * @param eligibility 可加工机台表
+         * @param generator 随机数生成器
+         */
+        void mutate(
+          double                  assignmentRate,
+          double                  sequenceRate,
+          const EligibilityTable &eligibility,
+          std::mt19937           &generator);
+
+        /**
+         * 检查染色体是否有效
+         */
+        bool isValid(const EligibilityTable &eligibility) const;
+
+        /**
+         * 修复无效染色体，线性时间
+         * 剔除加工顺序中越界和重复的批次，无效分配改为随机的可加工机台，缺失的批次追加到末尾
+         */
+        void repair(const EligibilityTable &eligibility, std::mt19937 &generator);
+
+    private:
+        std::vector<size_t> m_assignment;
+        std::vector<size_t> m_sequence;
+};
+
+}    // namespace schedule
+}    // namespace rtd
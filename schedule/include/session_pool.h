@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <soci/soci.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 池中的数据库会话，按查询ID缓存已准备的语句
+ * 同一时刻只租给一个线程，缓存无需加锁；重新连接时缓存随旧连接一起作废
+ */
+class PooledSession: public soci::session {
+    public:
+        PooledSession(const soci::backend_factory &backend, const std::string &connectionString);
+        ~PooledSession();
+
+        /**
+         * 取得查询对应的语句并绑定本次的参数和结果
+         * 首次使用时准备并缓存，之后解除上次的绑定后重新绑定，不再向数据库发送解析请求
+         * @param id 查询ID
+         * @param sql 查询语句，只在首次准备时使用
+         * @param elements use()/into()绑定，顺序与逐次执行时相同
+         * @return 已绑定、待execute的语句，下次以同一ID调用前有效
+         */
+        template<typename... Elements>
+        soci::statement &bind(const std::string &id, const std::string &sql, Elements &&...elements)
+        {
+            soci::statement &stmt = prepared(id, sql);
+            (stmt.exchange(std::forward<Elements>(elements)), ...);
+            stmt.define_and_bind();
+            return stmt;
+        }
+
+        /**
+         * 连接断开时重新连接并清空语句缓存
+         * @return 会话是否可用
+         */
+        bool ensureConnected();
+
+        /**
+         * 结束未读完结果的语句，归还到池中时调用
+         * SQLite中停在结果中间的语句（如只取一行的查询）会一直占着读事务，
+         * WAL模式下该连接之后的查询读到旧数据，否则阻塞其他连接的写入
+         */
+        void finishStatements();
+
+    private:
+        std::unordered_map<std::string, std::unique_ptr<soci::statement>> m_statements;
+
+        // 取得已准备且未绑定的语句
+        soci::statement &prepared(const std::string &id, const std::string &sql);
+};
+
+/**
+ * 单个数据源的数据库会话池
+ * 初始化时建立minConn个会话，不够用时按需新建直到maxConn个，达到上限后等待归还，超过timeout返回空。
+ * acquire返回的shared_ptr析构时把会话归还到池中，池本身由租出的会话共同持有。
+ * 租出前检查空闲会话的连接，断开的会话重新连接
+ */
+class SessionPool: public std::enable_shared_from_this<SessionPool> {
+    public:
+        SessionPool(
+          const soci::backend_factory &backend,
+          std::string                  connectionString,
+          size_t                       minConn,
+          size_t                       maxConn,
+          std::chrono::seconds         timeout);
+
+        /**
+         * 建立minConn个会话
+         * @return 是否全部建立成功
+         */
+        bool open();
+
+        /**
+         * 租用一个会话
+         * @return 会话，连接失败或等待超时时返回空
+         */
+        std::shared_ptr<PooledSession> acquire();
+
+        /**
+         * 最大会话数，即该数据源可以并发执行的查询数
+         */
+        size_t capacity() const
+        {
+            return m_maxConn;
+        }
+
+    private:
+        const soci::backend_factory &m_backend;
+        std::string                  m_connectionString;
+        size_t                       m_minConn;
+        size_t                       m_maxConn;
+        std::chrono::seconds         m_timeout;
+
+        std::mutex                                  m_mutex;
+        std::condition_variable                     m_available;
+        std::vector<std::unique_ptr<PooledSession>> m_idle;
+        size_t                                      m_total = 0;    // 已建立的会话数（含租出的）
+
+        // 归还会话
+        void release(PooledSession *session);
+};
+
+}    // namespace schedule
+}    // namespace rtd
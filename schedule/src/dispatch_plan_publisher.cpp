@@ -0,0 +1,159 @@
+#include "dispatch_plan_publisher.h"
+#include "dispatch_plan_layout.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <new>
+#include <numeric>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace rtd {
+namespace schedule {
+
+namespace {
+
+// 定长复制ID，保证以'\0'结尾
+void copyId(char *dest, const std::string &src)
+{
+    size_t length = std::min(src.size(), dispatch::kPlanIdLength - 1);
+    std::memcpy(dest, src.data(), length);
+    dest[length] = '\0';
+}
+
+}    // namespace
+
+DispatchPlanPublisher::DispatchPlanPublisher(const std::string &path)
+    : m_path(path), m_sequence(0)
+{}
+
+bool DispatchPlanPublisher::publish(const Schedule &schedule, const std::vector<std::string> &machineIds, double releaseTime)
+{
+    // 设备按ID排序，便于读取方二分查找
+    std::vector<size_t> machineOrder(machineIds.size());
+    std::iota(machineOrder.begin(), machineOrder.end(), 0);
+    std::sort(machineOrder.begin(), machineOrder.end(), [&machineIds](size_t a, size_t b) {
+        return machineIds[a] < machineIds[b];
+    });
+
+    size_t entryCount = 0;
+    for (size_t machineIdx: machineOrder) {
+        if (machineIdx < schedule.machineAssignments.size()) {
+            entryCount += schedule.machineAssignments[machineIdx].size();
+        }
+    }
+
+    const size_t equipmentOffset = sizeof(dispatch::PlanHeader);
+    const size_t entryOffset     = equipmentOffset + machineIds.size() * sizeof(dispatch::PlanEquipment);
+    const size_t fileSize        = entryOffset + entryCount * sizeof(dispatch::PlanEntry);
+
+    // 读取旧快照的发布序号，保证重启后序号仍然递增
+    int oldFd = ::open(m_path.c_str(), O_RDWR);
+    if (oldFd >= 0) {
+        dispatch::PlanHeader oldHeader;
+        if (::pread(oldFd, &oldHeader, sizeof(oldHeader), 0) == static_cast<ssize_t>(sizeof(oldHeader)) && oldHeader.magic == dispatch::kPlanMagic) {
+            m_sequence = std::max(m_sequence, oldHeader.sequence);
+        }
+    }
+
+    // 写入临时文件
+    std::string tmpPath = m_path + ".tmp";
+    int         fd      = ::open(tmpPath.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "Failed to create dispatch plan file " << tmpPath << ": " << std::strerror(errno) << std::endl;
+        if (oldFd >= 0) ::close(oldFd);
+        return false;
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(fileSize)) != 0) {
+        std::cerr << "Failed to resize dispatch plan file: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        ::unlink(tmpPath.c_str());
+        if (oldFd >= 0) ::close(oldFd);
+        return false;
+    }
+
+    void *base = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        std::cerr << "Failed to map dispatch plan file: " << std::strerror(errno) << std::endl;
+        ::unlink(tmpPath.c_str());
+        if (oldFd >= 0) ::close(oldFd);
+        return false;
+    }
+
+    auto *header            = new (base) dispatch::PlanHeader();
+    header->magic           = dispatch::kPlanMagic;
+    header->version         = dispatch::kPlanVersion;
+    header->sequence        = ++m_sequence;
+    header->releaseTime     = releaseTime;
+    header->makespan        = schedule.makespan;
+    header->equipmentCount  = machineIds.size();
+    header->entryCount      = entryCount;
+    header->equipmentOffset = equipmentOffset;
+    header->entryOffset     = entryOffset;
+
+    auto *equipments = reinterpret_cast<dispatch::PlanEquipment *>(static_cast<char *>(base) + equipmentOffset);
+    auto *entries    = reinterpret_cast<dispatch::PlanEntry *>(static_cast<char *>(base) + entryOffset);
+
+    size_t nextEntry = 0;
+    for (size_t i = 0; i < machineOrder.size(); ++i) {
+        size_t machineIdx = machineOrder[i];
+        auto  &equipment  = equipments[i];
+
+        copyId(equipment.eqpId, machineIds[machineIdx]);
+        equipment.firstEntry = nextEntry;
+        equipment.entryCount = 0;
+
+        if (machineIdx >= schedule.machineAssignments.size()) {
+            continue;
+        }
+
+        for (const auto &job: schedule.machineAssignments[machineIdx]) {
+            auto &entry = entries[nextEntry++];
+            copyId(entry.lotId, job.lotId);
+            entry.processingTime = job.processingTime;
+            entry.startTime      = job.startTime;
+            entry.endTime        = job.endTime;
+            ++equipment.entryCount;
+        }
+    }
+
+    ::munmap(base, fileSize);
+
+    // 原子替换，读取方要么看到旧快照要么看到新快照
+    if (::rename(tmpPath.c_str(), m_path.c_str()) != 0) {
+        std::cerr << "Failed to publish dispatch plan " << m_path << ": " << std::strerror(errno) << std::endl;
+        ::unlink(tmpPath.c_str());
+        if (oldFd >= 0) ::close(oldFd);
+        return false;
+    }
+
+    if (oldFd >= 0) {
+        markSuperseded(oldFd);
+        ::close(oldFd);
+    }
+
+    return true;
+}
+
+void DispatchPlanPublisher::markSuperseded(int fd)
+{
+    void *base = ::mmap(nullptr, sizeof(dispatch::PlanHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        return;
+    }
+
+    auto *header = static_cast<dispatch::PlanHeader *>(base);
+    if (header->magic == dispatch::kPlanMagic) {
+        header->superseded.store(1, std::memory_order_release);
+    }
+
+    ::munmap(base, sizeof(dispatch::PlanHeader));
+}
+
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,89 @@
+#include "dispatch_writer.h"
+#include <iostream>
+
+namespace rtd {
+namespace schedule {
+
+DispatchWriter::DispatchWriter(ScheduleDataManager &dataManager, size_t queueCapacity, bool diff)
+    : m_dataManager(dataManager), m_capacity(queueCapacity), m_diff(diff)
+{}
+
+DispatchWriter::~DispatchWriter()
+{
+    stop();
+}
+
+void DispatchWriter::start()
+{
+    if (m_capacity == 0 || m_thread.joinable()) {
+        return;
+    }
+
+    m_stopping = false;
+    m_thread   = std::thread(&DispatchWriter::run, this);
+}
+
+void DispatchWriter::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void DispatchWriter::submit(Results results, double releaseTime)
+{
+    if (!m_thread.joinable()) {
+        write({std::move(results), releaseTime});
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.size() >= m_capacity) {
+            std::cerr << "写入队列已满，丢弃发布时间为 " << m_queue.front().releaseTime << " 的未写入方案" << std::endl;
+            m_queue.pop_front();
+        }
+        m_queue.push_back({std::move(results), releaseTime});
+    }
+    m_cv.notify_one();
+}
+
+void DispatchWriter::run()
+{
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+
+            // 停止时先把队列写完
+            if (m_queue.empty()) {
+                return;
+            }
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        write(job);
+    }
+}
+
+void DispatchWriter::write(const Job &job)
+{
+    bool saved = m_diff ? m_dataManager.saveDispatchDiff(job.results, job.releaseTime) : m_dataManager.saveDispatchResults(job.results);
+    if (saved) {
+        std::cout << "成功保存 " << job.results.size() << " 条调度记录" << std::endl;
+    }
+    else {
+        std::cerr << "保存调度结果时出错" << std::endl;
+    }
+}
+
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,673 @@
+#include "distributed_islands.h"
+#include "job_scheduler.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace rtd {
+namespace schedule {
+
+namespace {
+
+/**
+ * 二进制协议
+ * 每条消息由12字节帧头和负载组成，数值均按本机字节序（集群内同构x86_64）
+ *   HELLO     工作进程 -> 协调进程  u32 协议版本
+ *   PROBLEM   协调进程 -> 工作进程  GA参数 + u32 染色体编码 + 稀疏处理时间(u32 lot, u32 machine, f64 time)
+ *   MIGRANTS  双向                  u32 个数, 每个个体: u32 基因数 + u32 基因[]
+ *   RESULT    工作进程 -> 协调进程  f64 适应度 + 一个个体
+ *   SHUTDOWN  协调进程 -> 工作进程  空
+ */
+constexpr uint32_t PROTOCOL_MAGIC    = 0x49445452;    // "RTDI"
+constexpr uint32_t PROTOCOL_VERSION  = 2;
+constexpr uint32_t MAX_PAYLOAD       = 256u * 1024 * 1024;
+constexpr uint64_t MAX_PROBLEM_CELLS = 32u * 1024 * 1024;    // 工作进程按稠密矩阵展开处理时间，限制批次数 * 机台数
+constexpr uint64_t MAX_INDIVIDUALS   = 1024u * 1024;         // 限制岛数 * 每岛种群大小
+
+enum class MessageType : uint8_t {
+    HELLO    = 1,
+    PROBLEM  = 2,
+    MIGRANTS = 3,
+    RESULT   = 4,
+    SHUTDOWN = 5
+};
+
+struct FrameHeader {
+        uint32_t magic;
+        uint8_t  type;
+        uint8_t  reserved[3];
+        uint32_t length;
+};
+
+static_assert(sizeof(FrameHeader) == 12, "unexpected frame header size");
+
+// 负载写入器
+class PayloadWriter {
+    public:
+        template<typename T>
+        void put(T value)
+        {
+            const char *bytes = reinterpret_cast<const char *>(&value);
+            m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        void putChromosome(const Chromosome &chromosome)
+        {
+            const auto &genes = chromosome.getGenes();
+            put<uint32_t>(static_cast<uint32_t>(genes.size()));
+            for (size_t gene: genes) {
+                if (gene > std::numeric_limits<uint32_t>::max()) {
+                    throw std::overflow_error("Gene value exceeds protocol range");
+                }
+                put<uint32_t>(static_cast<uint32_t>(gene));
+            }
+        }
+
+        const std::vector<char> &data() const { return m_buffer; }
+
+    private:
+        std::vector<char> m_buffer;
+};
+
+// 负载读取器，越界时抛出异常
+class PayloadReader {
+    public:
+        explicit PayloadReader(const std::vector<char> &buffer)
+            : m_buffer(buffer), m_offset(0) {}
+
+        template<typename T>
+        T get()
+        {
+            if (m_offset + sizeof(T) > m_buffer.size()) {
+                throw std::runtime_error("Truncated message payload");
+            }
+            T value;
+            std::memcpy(&value, m_buffer.data() + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+            return value;
+        }
+
+        // 尚未读取的字节数
+        size_t remaining() const { return m_buffer.size() - m_offset; }
+
+        Chromosome getChromosome()
+        {
+            uint32_t length = get<uint32_t>();
+
+            // 先按剩余字节检查长度，再按长度分配，避免损坏的长度字段触发超大分配
+            if (length > (m_buffer.size() - m_offset) / sizeof(uint32_t)) {
+                throw std::runtime_error("Truncated message payload");
+            }
+
+            std::vector<size_t> genes;
+            genes.reserve(length);
+            for (uint32_t i = 0; i < length; ++i) {
+                genes.push_back(get<uint32_t>());
+            }
+            return Chromosome(genes);
+        }
+
+    private:
+        const std::vector<char> &m_buffer;
+        size_t                   m_offset;
+};
+
+// 等待套接字可读
+bool waitReadable(int fd, int timeoutSeconds)
+{
+    pollfd pfd {fd, POLLIN, 0};
+    int    ready = ::poll(&pfd, 1, timeoutSeconds < 0 ? -1 : timeoutSeconds * 1000);
+    return ready > 0;
+}
+
+bool sendAll(int fd, const char *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t n = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool recvAll(int fd, char *data, size_t size, int timeoutSeconds)
+{
+    while (size > 0) {
+        if (!waitReadable(fd, timeoutSeconds)) {
+            return false;
+        }
+        ssize_t n = ::recv(fd, data, size, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool sendMessage(int fd, MessageType type, const std::vector<char> &payload)
+{
+    FrameHeader header {PROTOCOL_MAGIC, static_cast<uint8_t>(type), {0, 0, 0}, static_cast<uint32_t>(payload.size())};
+    return sendAll(fd, reinterpret_cast<const char *>(&header), sizeof(header)) && sendAll(fd, payload.data(), payload.size());
+}
+
+bool recvMessage(int fd, MessageType &type, std::vector<char> &payload, int timeoutSeconds)
+{
+    FrameHeader header;
+    if (!recvAll(fd, reinterpret_cast<char *>(&header), sizeof(header), timeoutSeconds)) {
+        return false;
+    }
+
+    if (header.magic != PROTOCOL_MAGIC || header.length > MAX_PAYLOAD) {
+        return false;
+    }
+
+    type = static_cast<MessageType>(header.type);
+    payload.resize(header.length);
+    return recvAll(fd, payload.data(), payload.size(), timeoutSeconds);
+}
+
+std::vector<char> encodeMigrants(const std::vector<Chromosome> &migrants)
+{
+    PayloadWriter writer;
+    writer.put<uint32_t>(static_cast<uint32_t>(migrants.size()));
+    for (const auto &migrant: migrants) {
+        writer.putChromosome(migrant);
+    }
+    return writer.data();
+}
+
+std::vector<Chromosome> decodeMigrants(const std::vector<char> &payload)
+{
+    PayloadReader           reader(payload);
+    uint32_t                count = reader.get<uint32_t>();
+    std::vector<Chromosome> migrants;
+    for (uint32_t i = 0; i < count; ++i) {
+        migrants.push_back(reader.getChromosome());
+    }
+    return migrants;
+}
+
+void setNoDelay(int fd)
+{
+    int flag = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+}
+
+/**
+ * 工作进程侧的迁移通道
+ */
+class WorkerTransport: public MigrationTransport {
+    public:
+        WorkerTransport(int fd, int timeoutSeconds)
+            : m_fd(fd), m_timeoutSeconds(timeoutSeconds) {}
+
+        void beginRun(const DistributedRunSpec &) override {}
+
+        std::vector<Chromosome> exchangeMigrants(const std::vector<Chromosome> &emigrants) override
+        {
+            if (!sendMessage(m_fd, MessageType::MIGRANTS, encodeMigrants(emigrants))) {
+                throw std::runtime_error("Failed to send migrants to coordinator");
+            }
+
+            MessageType       type;
+            std::vector<char> payload;
+            if (!recvMessage(m_fd, type, payload, m_timeoutSeconds) || type != MessageType::MIGRANTS) {
+                throw std::runtime_error("Failed to receive migrants from coordinator");
+            }
+
+            return decodeMigrants(payload);
+        }
+
+        std::vector<Chromosome> finishRun(const Chromosome &localBest, double localBestFitness) override
+        {
+            PayloadWriter writer;
+            writer.put<double>(localBestFitness);
+            writer.putChromosome(localBest);
+            if (!sendMessage(m_fd, MessageType::RESULT, writer.data())) {
+                throw std::runtime_error("Failed to send result to coordinator");
+            }
+            return {};
+        }
+
+    private:
+        int m_fd;
+        int m_timeoutSeconds;
+};
+
+}    // namespace
+
+// ==================== IslandCoordinator ====================
+
+IslandCoordinator::IslandCoordinator(int port, int timeoutSeconds)
+    : m_port(port), m_timeoutSeconds(timeoutSeconds), m_listenFd(-1), m_running(false)
+{}
+
+IslandCoordinator::~IslandCoordinator()
+{
+    stop();
+}
+
+bool IslandCoordinator::start()
+{
+    m_listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (m_listenFd < 0) {
+        std::cerr << "Failed to create coordinator socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    int reuse = 1;
+    ::setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr {};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port        = htons(static_cast<uint16_t>(m_port));
+
+    if (::bind(m_listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || ::listen(m_listenFd, 64) != 0) {
+        std::cerr << "Failed to listen on port " << m_port << ": " << std::strerror(errno) << std::endl;
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+
+    m_running      = true;
+    m_acceptThread = std::thread(&IslandCoordinator::acceptLoop, this);
+    return true;
+}
+
+void IslandCoordinator::stop()
+{
+    if (!m_running.exchange(false)) {
+        return;
+    }
+
+    if (m_acceptThread.joinable()) {
+        m_acceptThread.join();
+    }
+
+    ::close(m_listenFd);
+    m_listenFd = -1;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto *workers: {&m_pendingWorkers, &m_activeWorkers}) {
+        for (int fd: *workers) {
+            sendMessage(fd, MessageType::SHUTDOWN, {});
+            ::close(fd);
+        }
+        workers->clear();
+    }
+}
+
+size_t IslandCoordinator::getWorkerCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pendingWorkers.size() + m_activeWorkers.size();
+}
+
+void IslandCoordinator::acceptLoop()
+{
+    while (m_running) {
+        if (!waitReadable(m_listenFd, 1)) {
+            continue;
+        }
+
+        int fd = ::accept(m_listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+
+        // 校验握手消息
+        MessageType       type;
+        std::vector<char> payload;
+        if (!recvMessage(fd, type, payload, m_timeoutSeconds) || type != MessageType::HELLO) {
+            ::close(fd);
+            continue;
+        }
+
+        try {
+            PayloadReader reader(payload);
+            if (reader.get<uint32_t>() != PROTOCOL_VERSION) {
+                std::cerr << "Rejected island worker with incompatible protocol version" << std::endl;
+                ::close(fd);
+                continue;
+            }
+        }
+        catch (const std::exception &) {
+            ::close(fd);
+            continue;
+        }
+
+        setNoDelay(fd);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingWorkers.push_back(fd);
+        std::cout << "岛屿工作进程已连接，当前 " << (m_pendingWorkers.size() + m_activeWorkers.size()) << " 个" << std::endl;
+    }
+}
+
+void IslandCoordinator::dropWorker(size_t index)
+{
+    std::cerr << "岛屿工作进程响应超时或断开，移出本次求解" << std::endl;
+    ::close(m_activeWorkers[index]);
+    m_activeWorkers.erase(m_activeWorkers.begin() + index);
+}
+
+void IslandCoordinator::beginRun(const DistributedRunSpec &spec)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // 新连接的工作进程从本次求解开始参与
+    m_activeWorkers.insert(m_activeWorkers.end(), m_pendingWorkers.begin(), m_pendingWorkers.end());
+    m_pendingWorkers.clear();
+
+    if (m_activeWorkers.empty()) {
+        return;
+    }
+
+    PayloadWriter writer;
+    writer.put<uint32_t>(static_cast<uint32_t>(spec.islandCount));
+    writer.put<uint32_t>(static_cast<uint32_t>(spec.populationPerIsland));
+    writer.put<uint32_t>(static_cast<uint32_t>(spec.generationCount));
+    writer.put<uint32_t>(static_cast<uint32_t>(spec.migrationInterval));
+    writer.put<double>(spec.migrationRate);
+    writer.put<double>(spec.crossoverRate);
+    writer.put<double>(spec.mutationRate);
+    writer.put<uint32_t>(static_cast<uint32_t>(spec.elitismCount));
+    writer.put<uint32_t>(static_cast<uint32_t>(spec.lotCount));
+    writer.put<uint32_t>(static_cast<uint32_t>(spec.machineCount));
+    writer.put<uint32_t>(static_cast<uint32_t>(spec.encoding));
+
+    // 处理时间矩阵按稀疏三元组传输
+    const auto &matrix = *spec.processingTimes;
+    uint32_t    nonZero = 0;
+    for (const auto &row: matrix) {
+        for (double time: row) {
+            if (time > 0) ++nonZero;
+        }
+    }
+    writer.put<uint32_t>(nonZero);
+    for (size_t lot = 0; lot < matrix.size(); ++lot) {
+        for (size_t machine = 0; machine < matrix[lot].size(); ++machine) {
+            if (matrix[lot][machine] > 0) {
+                writer.put<uint32_t>(static_cast<uint32_t>(lot));
+                writer.put<uint32_t>(static_cast<uint32_t>(machine));
+                writer.put<double>(matrix[lot][machine]);
+            }
+        }
+    }
+
+    for (size_t i = m_activeWorkers.size(); i-- > 0;) {
+        if (!sendMessage(m_activeWorkers[i], MessageType::PROBLEM, writer.data())) {
+            dropWorker(i);
+        }
+    }
+
+    std::cout << "分布式求解: " << m_activeWorkers.size() << " 个工作进程参与" << std::endl;
+}
+
+std::vector<Chromosome> IslandCoordinator::exchangeMigrants(const std::vector<Chromosome> &emigrants)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_activeWorkers.empty()) {
+        return {};
+    }
+
+    // 收集各工作进程的移民，进程环: 协调进程(0) -> 工作进程1 -> ... -> 工作进程n -> 协调进程
+    std::vector<std::vector<char>> outgoing;
+    outgoing.push_back(encodeMigrants(emigrants));
+
+    for (size_t i = 0; i < m_activeWorkers.size();) {
+        MessageType       type;
+        std::vector<char> payload;
+        if (recvMessage(m_activeWorkers[i], type, payload, m_timeoutSeconds) && type == MessageType::MIGRANTS) {
+            outgoing.push_back(std::move(payload));
+            ++i;
+        }
+        else {
+            dropWorker(i);
+        }
+    }
+
+    // 每个节点接收环上前一个节点的移民
+    const size_t nodeCount = outgoing.size();
+    if (nodeCount == 1) {
+        return {};
+    }
+
+    for (size_t i = m_activeWorkers.size(); i-- > 0;) {
+        size_t node = i + 1;
+        if (!sendMessage(m_activeWorkers[i], MessageType::MIGRANTS, outgoing[node - 1])) {
+            dropWorker(i);
+        }
+    }
+
+    return decodeMigrants(outgoing[nodeCount - 1]);
+}
+
+std::vector<Chromosome> IslandCoordinator::finishRun(const Chromosome &, double)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // 工作进程声称的适应度不可信，只收集个体，由调度器修复并重新评估后比较
+    std::vector<Chromosome> results;
+
+    for (size_t i = 0; i < m_activeWorkers.size();) {
+        MessageType       type;
+        std::vector<char> payload;
+        if (!recvMessage(m_activeWorkers[i], type, payload, m_timeoutSeconds) || type != MessageType::RESULT) {
+            dropWorker(i);
+            continue;
+        }
+
+        try {
+            PayloadReader reader(payload);
+            reader.get<double>();
+            results.push_back(reader.getChromosome());
+        }
+        catch (const std::exception &e) {
+            std::cerr << "Invalid result from island worker: " << e.what() << std::endl;
+        }
+        ++i;
+    }
+
+    // 本次求解结束后，工作进程回到等待状态
+    m_pendingWorkers.insert(m_pendingWorkers.end(), m_activeWorkers.begin(), m_activeWorkers.end());
+    m_activeWorkers.clear();
+
+    return results;
+}
+
+// ==================== IslandWorker ====================
+
+IslandWorker::IslandWorker(const std::string &host, int port, int timeoutSeconds)
+    : m_host(host), m_port(port), m_timeoutSeconds(timeoutSeconds)
+{}
+
+int IslandWorker::connectToCoordinator()
+{
+    addrinfo hints {};
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo   *result = nullptr;
+    std::string port   = std::to_string(m_port);
+    if (::getaddrinfo(m_host.c_str(), port.c_str(), &hints, &result) != 0) {
+        return -1;
+    }
+
+    int fd = -1;
+    for (addrinfo *ai = result; ai; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            break;
+        }
+        ::close(fd);
+        fd = -1;
+    }
+    ::freeaddrinfo(result);
+
+    if (fd < 0) {
+        return -1;
+    }
+
+    setNoDelay(fd);
+
+    PayloadWriter writer;
+    writer.put<uint32_t>(PROTOCOL_VERSION);
+    if (!sendMessage(fd, MessageType::HELLO, writer.data())) {
+        ::close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+int IslandWorker::run(const std::atomic<bool> &running)
+{
+    while (running) {
+        int fd = connectToCoordinator();
+        if (fd < 0) {
+            // 协调进程尚未启动，稍后重试
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            continue;
+        }
+
+        std::cout << "已连接协调进程 " << m_host << ":" << m_port << std::endl;
+
+        while (running) {
+            // 两次求解之间可能间隔一个调度周期，分段等待以便响应退出信号
+            if (!waitReadable(fd, 1)) {
+                continue;
+            }
+
+            MessageType       type;
+            std::vector<char> payload;
+            if (!recvMessage(fd, type, payload, m_timeoutSeconds)) {
+                std::cerr << "与协调进程的连接中断，准备重连" << std::endl;
+                break;
+            }
+
+            if (type == MessageType::SHUTDOWN) {
+                std::cout << "协调进程通知退出" << std::endl;
+                ::close(fd);
+                return 0;
+            }
+
+            if (type != MessageType::PROBLEM) {
+                continue;
+            }
+
+            try {
+                solve(fd, payload);
+            }
+            catch (const std::exception &e) {
+                std::cerr << "分布式求解失败: " << e.what() << std::endl;
+                break;
+            }
+        }
+
+        ::close(fd);
+    }
+
+    return 0;
+}
+
+void IslandWorker::solve(int fd, const std::vector<char> &payload)
+{
+    PayloadReader reader(payload);
+
+    size_t islandCount         = reader.get<uint32_t>();
+    size_t populationPerIsland = reader.get<uint32_t>();
+    size_t generationCount     = reader.get<uint32_t>();
+    size_t migrationInterval   = reader.get<uint32_t>();
+    double migrationRate       = reader.get<double>();
+    double crossoverRate       = reader.get<double>();
+    double mutationRate        = reader.get<double>();
+    size_t elitismCount        = reader.get<uint32_t>();
+    size_t lotCount            = reader.get<uint32_t>();
+    size_t machineCount        = reader.get<uint32_t>();
+    size_t encodingValue       = reader.get<uint32_t>();
+    size_t nonZero             = reader.get<uint32_t>();
+
+    // 分配前先校验，避免损坏的负载触发超大分配或非法的编码值
+    constexpr size_t TRIPLE_SIZE = 2 * sizeof(uint32_t) + sizeof(double);
+    if (lotCount == 0 || machineCount == 0 || static_cast<uint64_t>(lotCount) * machineCount > MAX_PROBLEM_CELLS) {
+        throw std::runtime_error("Problem size out of range");
+    }
+    if (islandCount == 0 || populationPerIsland == 0 || static_cast<uint64_t>(islandCount) * populationPerIsland > MAX_INDIVIDUALS) {
+        throw std::runtime_error("Population size out of range");
+    }
+    if (encodingValue != static_cast<size_t>(ChromosomeEncoding::PERMUTATION) && encodingValue != static_cast<size_t>(ChromosomeEncoding::TWO_PART)) {
+        throw std::runtime_error("Unknown chromosome encoding");
+    }
+    if (nonZero > reader.remaining() / TRIPLE_SIZE) {
+        throw std::runtime_error("Truncated message payload");
+    }
+    auto encoding = static_cast<ChromosomeEncoding>(encodingValue);
+
+    std::vector<std::vector<double>> processingTimes(lotCount, std::vector<double>(machineCount, 0.0));
+    for (size_t i = 0; i < nonZero; ++i) {
+        uint32_t lot     = reader.get<uint32_t>();
+        uint32_t machine = reader.get<uint32_t>();
+        double   time    = reader.get<double>();
+        if (lot >= lotCount || machine >= machineCount) {
+            throw std::runtime_error("Processing time index out of range");
+        }
+        processingTimes[lot][machine] = time;
+    }
+
+    // 工作进程只需要索引，ID用序号代替
+    std::vector<std::string> lotIds(lotCount);
+    std::vector<std::string> machineIds(machineCount);
+    for (size_t i = 0; i < lotCount; ++i) lotIds[i] = std::to_string(i);
+    for (size_t j = 0; j < machineCount; ++j) machineIds[j] = std::to_string(j);
+
+    auto scheduler = JobScheduler::create();
+    scheduler->setLots(lotIds);
+    scheduler->setMachines(machineIds);
+    scheduler->setProcessingTimes(processingTimes);
+    scheduler->setIslandCount(islandCount);
+    scheduler->setPopulationSize(islandCount * populationPerIsland);
+    scheduler->setGenerationCount(generationCount);
+    scheduler->setMigrationInterval(migrationInterval);
+    scheduler->setMigrationRate(migrationRate);
+    scheduler->setCrossoverRate(crossoverRate);
+    scheduler->setMutationRate(mutationRate);
+    scheduler->setElitismCount(elitismCount);
+    scheduler->setEncoding(encoding);
+    scheduler->setMigrationTransport(std::make_shared<WorkerTransport>(fd, m_timeoutSeconds));
+
+    auto     startTime = std::chrono::steady_clock::now();
+    Schedule schedule  = scheduler->calculateSchedule();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    std::cout << "本地岛屿求解完成，耗时 " << elapsed.count() << " 秒，本地最优完工时间: " << schedule.makespan << std::endl;
+}
+
+}    // namespace schedule
+}    // namespace rtd
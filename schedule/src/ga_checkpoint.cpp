@@ -0,0 +1,296 @@
+#include "ga_checkpoint.h"
+#include "mapped_layout.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rtd {
+namespace schedule {
+
+using namespace layout;
+
+namespace {
+
+constexpr uint32_t kCheckpointMagic   = 0x43445452;    // "RTDC"
+constexpr uint32_t kCheckpointVersion = 1;
+
+// mt19937的完整状态：624个状态字加当前位置
+constexpr size_t kRngStateWords = std::mt19937::state_size + 1;
+
+struct CheckpointHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t fingerprint;
+        uint64_t generation;
+        uint64_t lotCount;
+        uint64_t machineCount;
+        uint64_t islandCount;
+        uint64_t populationPerIsland;
+        uint64_t geneStride;    // 每个个体的基因槽位数（取最长个体）
+        uint64_t bestLength;
+        double   bestFitness;
+        uint64_t lotIdOffset;
+        uint64_t machineIdOffset;
+        uint64_t lengthOffset;
+        uint64_t geneOffset;
+        uint64_t fitnessOffset;
+        uint64_t rngOffset;
+        uint64_t bestOffset;
+        uint64_t fileSize;
+};
+
+/**
+ * 检查各段按写入顺序排列、起点对齐，且每段都不越过下一段的起点，
+ * 通过后按头部中的数量访问各段不会越界
+ */
+bool validSections(const CheckpointHeader &header)
+{
+    const uint64_t offsets[] = {header.lotIdOffset, header.machineIdOffset, header.lengthOffset, header.geneOffset, header.fitnessOffset, header.rngOffset, header.bestOffset};
+    uint64_t       previous  = sizeof(CheckpointHeader);
+    for (uint64_t offset: offsets) {
+        if (offset < previous || !isAligned8(offset)) {
+            return false;
+        }
+        previous = offset;
+    }
+
+    // 个体数和基因槽位数的乘积不能溢出
+    if (header.populationPerIsland != 0 && header.islandCount > UINT64_MAX / header.populationPerIsland) {
+        return false;
+    }
+    const uint64_t individualCount = header.islandCount * header.populationPerIsland;
+    if (header.geneStride != 0 && individualCount > UINT64_MAX / header.geneStride) {
+        return false;
+    }
+
+    return sectionFits(header.lengthOffset, individualCount, sizeof(uint32_t), header.geneOffset) && sectionFits(header.geneOffset, individualCount * header.geneStride, sizeof(uint32_t), header.fitnessOffset) && sectionFits(header.fitnessOffset, individualCount, sizeof(double), header.rngOffset) && sectionFits(header.rngOffset, header.islandCount, kRngStateWords * sizeof(uint32_t), header.bestOffset) && sectionFits(header.bestOffset, header.bestLength, sizeof(uint32_t), header.fileSize);
+}
+
+void saveRng(const std::mt19937 &rng, uint32_t *dest)
+{
+    std::stringstream state;
+    state << rng;
+    for (size_t i = 0; i < kRngStateWords; ++i) {
+        state >> dest[i];
+    }
+}
+
+void loadRng(const uint32_t *src, std::mt19937 &rng)
+{
+    std::stringstream state;
+    for (size_t i = 0; i < kRngStateWords; ++i) {
+        state << src[i] << ' ';
+    }
+    state >> rng;
+}
+
+}    // namespace
+
+bool GACheckpoint::write(const std::string &path) const
+{
+    const size_t islandCount         = populations.size();
+    const size_t populationPerIsland = islandCount > 0 ? populations[0].size() : 0;
+    const size_t individualCount     = islandCount * populationPerIsland;
+
+    size_t geneStride = 0;
+    for (const auto &population: populations) {
+        if (population.size() != populationPerIsland) {
+            return false;    // 各岛种群规模必须一致
+        }
+        for (const auto &chromosome: population) {
+            geneStride = std::max(geneStride, chromosome.getLength());
+        }
+    }
+    if (fitness.size() != islandCount || rngs.size() != islandCount) {
+        return false;
+    }
+
+    CheckpointHeader header {};
+    header.magic               = kCheckpointMagic;
+    header.version             = kCheckpointVersion;
+    header.fingerprint         = fingerprint;
+    header.generation          = generation;
+    header.lotCount            = lotIds.size();
+    header.machineCount        = machineIds.size();
+    header.islandCount         = islandCount;
+    header.populationPerIsland = populationPerIsland;
+    header.geneStride          = geneStride;
+    header.bestLength          = bestChromosome.getLength();
+    header.bestFitness         = bestFitness;
+    header.lotIdOffset         = align8(sizeof(CheckpointHeader));
+    header.machineIdOffset     = align8(header.lotIdOffset + idSectionSize(lotIds));
+    header.lengthOffset        = align8(header.machineIdOffset + idSectionSize(machineIds));
+    header.geneOffset          = align8(header.lengthOffset + individualCount * sizeof(uint32_t));
+    header.fitnessOffset       = align8(header.geneOffset + individualCount * geneStride * sizeof(uint32_t));
+    header.rngOffset           = header.fitnessOffset + individualCount * sizeof(double);
+    header.bestOffset          = header.rngOffset + islandCount * kRngStateWords * sizeof(uint32_t);
+    header.fileSize            = align8(header.bestOffset + header.bestLength * sizeof(uint32_t));
+
+    // 写入临时文件
+    std::string tmpPath = path + ".tmp";
+    int         fd      = ::open(tmpPath.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "Failed to create checkpoint file " << tmpPath << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(header.fileSize)) != 0) {
+        std::cerr << "Failed to resize checkpoint file: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+
+    void *mapped = ::mmap(nullptr, header.fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        std::cerr << "Failed to map checkpoint file: " << std::strerror(errno) << std::endl;
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+
+    char *base = static_cast<char *>(mapped);
+    std::memcpy(base, &header, sizeof(header));
+    writeIds(base + header.lotIdOffset, lotIds);
+    writeIds(base + header.machineIdOffset, machineIds);
+
+    auto *lengths = reinterpret_cast<uint32_t *>(base + header.lengthOffset);
+    auto *genes   = reinterpret_cast<uint32_t *>(base + header.geneOffset);
+    auto *scores  = reinterpret_cast<double *>(base + header.fitnessOffset);
+    auto *states  = reinterpret_cast<uint32_t *>(base + header.rngOffset);
+    auto *best    = reinterpret_cast<uint32_t *>(base + header.bestOffset);
+
+    for (size_t island = 0; island < islandCount; ++island) {
+        for (size_t i = 0; i < populationPerIsland; ++i) {
+            size_t      slot       = island * populationPerIsland + i;
+            const auto &chromosome = populations[island][i].getGenes();
+
+            lengths[slot] = static_cast<uint32_t>(chromosome.size());
+            for (size_t g = 0; g < chromosome.size(); ++g) {
+                genes[slot * geneStride + g] = static_cast<uint32_t>(chromosome[g]);
+            }
+            scores[slot] = fitness[island][i];
+        }
+        saveRng(rngs[island], states + island * kRngStateWords);
+    }
+
+    for (size_t g = 0; g < bestChromosome.getLength(); ++g) {
+        best[g] = static_cast<uint32_t>(bestChromosome.getGenes()[g]);
+    }
+
+    ::munmap(mapped, header.fileSize);
+
+    // 原子替换，崩溃时不会留下半写的检查点
+    if (::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Failed to write checkpoint " << path << ": " << std::strerror(errno) << std::endl;
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool GACheckpoint::read(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(CheckpointHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+    void        *mapped   = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    const char *base = static_cast<const char *>(mapped);
+    bool        ok   = false;
+
+    CheckpointHeader header;
+    std::memcpy(&header, base, sizeof(header));
+
+    if (header.magic == kCheckpointMagic && header.version == kCheckpointVersion && header.fileSize == fileSize && validSections(header) && readIds(base, header.lotIdOffset, header.lotCount, header.machineIdOffset, lotIds) && readIds(base, header.machineIdOffset, header.machineCount, header.lengthOffset, machineIds)) {
+        const auto *lengths = reinterpret_cast<const uint32_t *>(base + header.lengthOffset);
+        const auto *genes   = reinterpret_cast<const uint32_t *>(base + header.geneOffset);
+        const auto *scores  = reinterpret_cast<const double *>(base + header.fitnessOffset);
+        const auto *states  = reinterpret_cast<const uint32_t *>(base + header.rngOffset);
+        const auto *best    = reinterpret_cast<const uint32_t *>(base + header.bestOffset);
+
+        fingerprint = header.fingerprint;
+        generation  = header.generation;
+        bestFitness = header.bestFitness;
+        populations.assign(header.islandCount, {});
+        fitness.assign(header.islandCount, {});
+        rngs.assign(header.islandCount, std::mt19937());
+
+        ok = true;
+        for (size_t island = 0; island < header.islandCount && ok; ++island) {
+            populations[island].reserve(header.populationPerIsland);
+            fitness[island].reserve(header.populationPerIsland);
+
+            for (size_t i = 0; i < header.populationPerIsland; ++i) {
+                size_t slot = island * header.populationPerIsland + i;
+                if (lengths[slot] > header.geneStride) {
+                    ok = false;
+                    break;
+                }
+
+                const uint32_t *first = genes + slot * header.geneStride;
+                populations[island].emplace_back(std::vector<size_t>(first, first + lengths[slot]));
+                fitness[island].push_back(scores[slot]);
+            }
+            loadRng(states + island * kRngStateWords, rngs[island]);
+        }
+
+        bestChromosome = Chromosome(std::vector<size_t>(best, best + header.bestLength));
+    }
+
+    ::munmap(mapped, fileSize);
+    return ok;
+}
+
+uint64_t GACheckpoint::fingerprintOf(
+  const std::vector<std::string>         &lotIds,
+  const std::vector<std::string>         &machineIds,
+  const std::vector<std::vector<double>> &processingTimes)
+{
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto     mix  = [&hash](const void *data, size_t size) {
+        const auto *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ULL;
+        }
+    };
+
+    for (const auto &id: lotIds) {
+        mix(id.data(), id.size());
+        mix("\0", 1);
+    }
+    for (const auto &id: machineIds) {
+        mix(id.data(), id.size());
+        mix("\0", 1);
+    }
+    for (const auto &row: processingTimes) {
+        mix(row.data(), row.size() * sizeof(double));
+    }
+
+    return hash;
+}
+
+}    // namespace schedule
+}    // namespace rtd
@@ -1,13 +1,134 @@
 #include "job_scheduler_impl.h"
+#include "ga_checkpoint.h"
+#include "schedule_probe.h"
 #include <chrono>
-#include <thread>
+#include <iostream>
+#include <unordered_map>
 
 namespace rtd {
 namespace schedule {
 
-// 实现多岛遗传算法的派工调度器
-class JobSchedulerImpl::SchedulerGA: public algorithm::ArchipelagoGA<Chromosome, Schedule, double> {
+namespace {
+
+/**
+ * 遗传算法插桩策略
+ * 启用遥测时把岛内各阶段耗时累加到对应岛的PhaseTimes，迁移耗时累加到主线程的PhaseTimes；
+ * 以RTD_SCHEDULE_PROFILE编译时为岛演化记录探针。
+ * 子代生成中的耗时先累加到分块自己的Tally，分块结束后由岛线程并入岛的PhaseTimes，计时路径上不加锁。
+ * 岛内分块时各阶段耗时是各线程耗时之和
+ */
+struct GAInstrumentation {
+        using Tally = PhaseTimes;
+
+        std::vector<PhaseTimes> *islandPhases = nullptr;
+        PhaseTimes              *mainPhases   = nullptr;
+
+        // 阶段在PhaseTimes中对应的字段
+        static double *field(PhaseTimes &times, algorithm::GAPhase phase)
+        {
+            switch (phase) {
+                case algorithm::GAPhase::SELECTION:
+                    return &times.selection;
+                case algorithm::GAPhase::CROSSOVER:
+                    return &times.crossover;
+                case algorithm::GAPhase::MUTATION:
+                    return &times.mutation;
+                case algorithm::GAPhase::REPAIR:
+                    return &times.repair;
+                case algorithm::GAPhase::EVALUATION:
+                    return &times.evaluation;
+                case algorithm::GAPhase::MIGRATION:
+                    return &times.migration;
+                default:
+                    return nullptr;
+            }
+        }
+
+        double *target(algorithm::GAPhase phase, size_t island) const
+        {
+            if (phase == algorithm::GAPhase::MIGRATION) {
+                return mainPhases ? &mainPhases->migration : nullptr;
+            }
+            return islandPhases ? field((*islandPhases)[island], phase) : nullptr;
+        }
+
+        // 把分块的耗时并入岛的PhaseTimes，由演化该岛的线程调用
+        void commit(size_t island, const Tally &tally) const
+        {
+            if (!islandPhases) {
+                return;
+            }
+
+            PhaseTimes &phases = (*islandPhases)[island];
+            phases.selection  += tally.selection;
+            phases.crossover  += tally.crossover;
+            phases.mutation   += tally.mutation;
+            phases.repair     += tally.repair;
+            phases.evaluation += tally.evaluation;
+        }
+
+        class Scope {
+            public:
+                Scope(const GAInstrumentation &instrumentation, algorithm::GAPhase phase, size_t island)
+                    : Scope(instrumentation.target(phase, island), phase)
+                {}
+
+                Scope(const GAInstrumentation &instrumentation, algorithm::GAPhase phase, Tally &tally)
+                    : Scope(instrumentation.islandPhases ? field(tally, phase) : nullptr, phase)
+                {}
+
+                ~Scope()
+                {
+                    if (m_target) {
+                        *m_target += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+                    }
+                    if constexpr (probe::kEnabled) {
+                        if (m_probeStart >= 0) {
+                            probe::record("ga.evolve_island", m_probeStart, probe::nowNs() - m_probeStart);
+                        }
+                    }
+                }
+
+            private:
+                double                               *m_target;
+                std::chrono::steady_clock::time_point m_start;
+                int64_t                               m_probeStart;
+
+                Scope(double *target, algorithm::GAPhase phase)
+                    : m_target(target), m_probeStart(-1)
+                {
+                    if (m_target) {
+                        m_start = std::chrono::steady_clock::now();
+                    }
+                    if constexpr (probe::kEnabled) {
+                        if (phase == algorithm::GAPhase::ISLAND) {
+                            m_probeStart = probe::nowNs();
+                        }
+                    }
+                }
+        };
+};
+
+}    // namespace
+
+/**
+ * 实现多岛遗传算法的派工调度器，演化由基于策略的多岛引擎完成
+ * Genotype为染色体编码，种子个体、检查点和进程间迁移仍使用基因编码的Chromosome
+ */
+template<typename Genotype>
+class JobSchedulerImpl::SchedulerGA {
     public:
+        using Operators = GenotypeOperators<Genotype>;
+        using Engine    = algorithm::PolicyArchipelago<
+          Genotype,
+          ScheduleEvaluator,
+          algorithm::TournamentSelection<3>,
+          typename Operators::Crossover,
+          typename Operators::Mutation,
+          typename Operators::Repair,
+          algorithm::BestMigration,
+          GAInstrumentation>;
+
         SchedulerGA(
           size_t                                  numIslands,
           size_t                                  populationPerIsland,
@@ -18,220 +139,243 @@ class JobSchedulerImpl::SchedulerGA: public algorithm::ArchipelagoGA<Chromosome,
           const std::vector<std::string>         &machineIds,
           double                                  crossoverRate,
           double                                  mutationRate,
-          size_t                                  elitismCount)
-            : algorithm::ArchipelagoGA<Chromosome, Schedule, double>(numIslands, populationPerIsland), m_lotCount(lotCount), m_machineCount(machineCount), m_processingTimes(processingTimes), m_lotIds(lotIds), m_machineIds(machineIds), m_crossoverRate(crossoverRate), m_mutationRate(mutationRate), m_elitismCount(elitismCount), m_evaluator(lotCount, machineCount, processingTimes), m_bestFitness(-std::numeric_limits<double>::max())
+          size_t                                  elitismCount,
+          unsigned                                seed)
+            : m_numIslands(numIslands), m_populationPerIsland(populationPerIsland), m_lotCount(lotCount), m_machineCount(machineCount), m_processingTimes(processingTimes), m_lotIds(lotIds), m_machineIds(machineIds), m_crossoverRate(crossoverRate), m_mutationRate(mutationRate), m_elitismCount(elitismCount), m_rng(seed), m_eligibility(lotCount, machineCount, processingTimes), m_evaluator(lotCount, machineCount, processingTimes)
+        {}
+
+        /**
+         * 设置种子个体
+         * 每个岛保留一份种子，并用其变异副本填充半数种群，其余仍为随机个体以保持多样性
+         */
+        void setSeedChromosome(const Chromosome &seed)
         {
-            // 使用时间种子初始化随机数生成器
-            unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-            m_rng.seed(seed);
+            m_seedChromosome = Operators::fromChromosome(seed, m_eligibility, m_rng);
+            m_hasSeed        = true;
         }
 
-        void initialize() override
+        /**
+         * 设置迁移间隔（代数）
+         */
+        void setMigrationInterval(size_t interval)
         {
-            m_populations.resize(m_numIslands);
-            m_fitness.resize(m_numIslands);
+            m_migrationInterval = interval;
+        }
 
-            // 初始化每个岛的种群
-            for (size_t island = 0; island < m_numIslands; ++island) {
-                m_populations[island].resize(m_populationPerIsland);
-                m_fitness[island].resize(m_populationPerIsland);
-
-                // 创建初始随机染色体
-                for (size_t i = 0; i < m_populationPerIsland; ++i) {
-                    m_populations[island][i] = Chromosome::createRandom(
-                      m_lotCount, m_machineCount, m_processingTimes, m_rng);
-
-                    // 评估适应度
-                    m_fitness[island][i] = m_evaluator.evaluate(m_populations[island][i]);
-
-                    // 更新最佳解
-                    if (m_fitness[island][i] > m_bestFitness) {
-                        m_bestFitness    = m_fitness[island][i];
-                        m_bestChromosome = m_populations[island][i];
-
-                        // 更新最佳解的表现型
-                        m_bestPhenotype.clear();
-                        m_evaluator.evaluateAndUpdate(
-                          m_bestChromosome, m_bestPhenotype, m_lotIds, m_machineIds);
-                    }
-                }
-            }
+        /**
+         * 设置迁移率
+         */
+        void setMigrationRate(double rate)
+        {
+            m_migrationRate = rate;
+        }
 
-            // 构建迁移拓扑
-            buildMigrationTopology();
+        /**
+         * 设置进程间迁移通道
+         */
+        void setMigrationTransport(std::shared_ptr<MigrationTransport> transport)
+        {
+            m_transport = std::move(transport);
         }
 
-        void evolve(size_t generations) override
+        /**
+         * 设置演化线程数，为0时每个岛一个线程
+         */
+        void setThreadCount(size_t threads)
         {
-            for (size_t gen = 0; gen < generations; ++gen) {
-                // 每个岛独立演化
-                std::vector<std::thread> threads;
-                for (size_t island = 0; island < m_numIslands; ++island) {
-                    threads.push_back(std::thread(&SchedulerGA::evolveIsland, this, island));
-                }
+            m_threadCount = threads;
+        }
 
-                // 等待所有岛演化完成
-                for (auto &t: threads) {
-                    if (t.joinable()) {
-                        t.join();
-                    }
-                }
+        /**
+         * 设置岛内子代分块大小，为0时每个岛在一个线程内演化
+         */
+        void setOffspringChunkSize(size_t chunk)
+        {
+            m_offspringChunk = chunk;
+        }
 
-                // 周期性迁移个体
-                if ((gen + 1) % m_migrationInterval == 0) {
-                    migrateIndividuals();
-                }
-            }
+        /**
+         * 设置是否把演化线程绑定到CPU并按NUMA节点放置岛
+         */
+        void setThreadAffinity(bool enabled)
+        {
+            m_pinThreads = enabled;
         }
 
-        std::pair<Chromosome, Schedule> getBestSolution() const override
+        /**
+         * 设置求解进度回调
+         */
+        void setProgressCallback(ProgressCallback callback)
         {
-            return {m_bestChromosome, m_bestPhenotype};
+            m_progressCallback = std::move(callback);
         }
 
-        double getBestFitness() const override
+        /**
+         * 设置每代遥测回调
+         */
+        void setTelemetryCallback(TelemetryCallback callback)
         {
-            return m_bestFitness;
+            m_telemetryCallback = std::move(callback);
         }
 
-    protected:
-        void migrateIndividuals() override
+        /**
+         * 设置检查点文件
+         * @param path 检查点路径
+         * @param interval 写入间隔（代数），为0时只在演化结束时写入
+         * @param restore 初始化时是否先尝试从检查点恢复
+         */
+        void setCheckpoint(const std::string &path, size_t interval, bool restore)
         {
-            // 根据拓扑和迁移策略执行迁移
-            for (size_t sourceIsland = 0; sourceIsland < m_numIslands; ++sourceIsland) {
-                // 获取目标岛
-                std::vector<size_t> destinations = getDestinationIslands(sourceIsland);
-
-                // 计算每个目标岛要接收的移民数量
-                size_t migrantCount = static_cast<size_t>(m_populationPerIsland * m_migrationRate);
-                if (migrantCount == 0) migrantCount = 1;    // 至少迁移一个个体
-
-                // 选择迁移个体
-                std::vector<Chromosome> migrants = selectMigrants(sourceIsland, migrantCount);
-
-                // 发送移民到每个目标岛
-                for (size_t destIsland: destinations) {
-                    // 在目标岛中替换最差的个体
-                    for (size_t i = 0; i < migrants.size(); ++i) {
-                        // 找出目标岛中最差的个体
-                        size_t worstIdx     = 0;
-                        double worstFitness = m_fitness[destIsland][0];
-
-                        for (size_t j = 1; j < m_populationPerIsland; ++j) {
-                            if (m_fitness[destIsland][j] < worstFitness) {
-                                worstFitness = m_fitness[destIsland][j];
-                                worstIdx     = j;
-                            }
-                        }
+            m_checkpointPath     = path;
+            m_checkpointInterval = interval;
+            m_checkpointRestore  = restore;
+        }
 
-                        // 如果移民更好，则替换
-                        double migrantFitness = m_evaluator.evaluate(migrants[i]);
-                        if (migrantFitness > worstFitness) {
-                            m_populations[destIsland][worstIdx] = migrants[i];
-                            m_fitness[destIsland][worstIdx]     = migrantFitness;
-
-                            // 更新全局最佳解
-                            if (migrantFitness > m_bestFitness) {
-                                m_bestFitness    = migrantFitness;
-                                m_bestChromosome = migrants[i];
-
-                                // 更新最佳解的表现型
-                                m_bestPhenotype.clear();
-                                m_evaluator.evaluateAndUpdate(
-                                  m_bestChromosome, m_bestPhenotype, m_lotIds, m_machineIds);
-                            }
-                        }
+        void initialize()
+        {
+            RTD_PROBE_SCOPE("ga.initialize");
+
+            m_startTime = std::chrono::steady_clock::now();
+            m_islandPhases.assign(m_numIslands, PhaseTimes());
+            m_mainPhases         = PhaseTimes();
+            m_lastTelemetryTime  = m_startTime;
+            m_lastTelemetryEvals = 0;
+
+            // 在所有参数设置完成后创建引擎
+            algorithm::ArchipelagoConfig config;
+            config.islandCount         = m_numIslands;
+            config.populationPerIsland = m_populationPerIsland;
+            config.elitismCount        = m_elitismCount;
+            config.crossoverRate       = m_crossoverRate;
+            config.mutationRate        = m_mutationRate;
+            config.migrationInterval   = m_migrationInterval;
+            config.migrationRate       = m_migrationRate;
+            config.threadCount         = m_threadCount;
+            config.offspringChunk      = m_offspringChunk;
+            config.pinThreads          = m_pinThreads;
+
+            GAInstrumentation instrumentation;
+            if (m_telemetryCallback) {
+                instrumentation.islandPhases = &m_islandPhases;
+                instrumentation.mainPhases   = &m_mainPhases;
+            }
+
+            m_engine = std::make_unique<Engine>(
+              config,
+              m_evaluator,
+              algorithm::TournamentSelection<3>(),
+              typename Operators::Crossover {&m_eligibility},
+              typename Operators::Mutation {&m_eligibility},
+              typename Operators::Repair {&m_eligibility},
+              algorithm::BestMigration(),
+              instrumentation);
+
+            // 优先从检查点恢复，避免重启后冷启动
+            if (m_checkpointRestore && !m_checkpointPath.empty() && restoreCheckpoint()) {
+                if (m_hasSeed) {
+                    for (size_t island = 0; island < m_numIslands; ++island) {
+                        m_engine->acceptMigrant(island, m_seedChromosome);
                     }
                 }
+                reportProgress(0);
+                return;
             }
+
+            // 各岛并行创建初始种群，使用各岛自己的随机数生成器
+            m_engine->initialize(
+              [this](size_t, size_t i, std::mt19937 &rng) {
+                  if (m_hasSeed && i == 0) {
+                      return m_seedChromosome;
+                  }
+                  if (m_hasSeed && i < m_populationPerIsland / 2) {
+                      Genotype mutated = m_seedChromosome;
+                      typename Operators::Mutation {&m_eligibility}.mutate(mutated, m_mutationRate, rng);
+                      return mutated;
+                  }
+                  return Operators::createRandom(m_eligibility, rng);
+              },
+              m_rng);
+
+            reportProgress(0);
         }
 
-        std::vector<Chromosome> selectMigrants(size_t islandIndex, size_t count) override
+        void evolve(size_t generations)
         {
-            // 根据迁移策略选择移民，这里使用精英选择
-            std::vector<std::pair<double, size_t>> fitnessIndices;
-            for (size_t i = 0; i < m_populationPerIsland; ++i) {
-                fitnessIndices.push_back({m_fitness[islandIndex][i], i});
-            }
+            for (size_t gen = 0; gen < generations; ++gen) {
+                RTD_PROBE_SCOPE("ga.generation");
 
-            // 按适应度排序
-            std::sort(fitnessIndices.begin(), fitnessIndices.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+                // 各岛并行演化一代
+                m_engine->evolveGeneration();
 
-            // 选择前count个作为移民
-            std::vector<Chromosome> migrants;
-            for (size_t i = 0; i < count && i < fitnessIndices.size(); ++i) {
-                migrants.push_back(m_populations[islandIndex][fitnessIndices[i].second]);
+                // 周期性迁移个体
+                if (m_migrationInterval > 0 && (gen + 1) % m_migrationInterval == 0) {
+                    {
+                        RTD_PROBE_SCOPE("ga.migrate");
+                        m_engine->migrate();
+                    }
+
+                    // 与其他进程的岛屿交换移民
+                    if (m_transport) {
+                        RTD_PROBE_SCOPE("ga.remote_exchange");
+                        GAInstrumentation        instrumentation {nullptr, m_telemetryCallback ? &m_mainPhases : nullptr};
+                        GAInstrumentation::Scope scope(instrumentation, algorithm::GAPhase::MIGRATION, 0);
+                        exchangeRemoteMigrants();
+                    }
+                }
+
+                reportProgress(gen + 1);
+
+                // 周期性写入检查点
+                if (!m_checkpointPath.empty() && m_checkpointInterval > 0 && (gen + 1) % m_checkpointInterval == 0) {
+                    saveCheckpoint();
+                }
             }
 
-            return migrants;
+            if (!m_checkpointPath.empty()) {
+                saveCheckpoint();
+            }
         }
 
-        std::vector<size_t> getDestinationIslands(size_t sourceIsland) override
+        std::pair<Chromosome, Schedule> getBestSolution() const
         {
-            std::vector<size_t> destinations;
+            Chromosome best = Operators::toChromosome(m_engine->best(), m_eligibility);
+            Schedule   phenotype;
+            m_evaluator.evaluateAndUpdate(best, phenotype, m_lotIds, m_machineIds);
+            return {best, phenotype};
+        }
 
-            for (size_t i = 0; i < m_numIslands; ++i) {
-                if (i != sourceIsland && m_topologyMatrix[sourceIsland][i]) {
-                    destinations.push_back(i);
+        /**
+         * 在本进程最优个体和其他进程上报的个体中选出最优解
+         * 上报的个体与移民一样先修复，再在本地重新评估，不采信对方声称的适应度
+         */
+        std::pair<Chromosome, Schedule> getBestSolution(const std::vector<Chromosome> &remoteResults)
+        {
+            Genotype best        = m_engine->best();
+            double   bestFitness = m_evaluator.evaluate(best);
+            for (const auto &result: remoteResults) {
+                Genotype candidate = Operators::fromChromosome(result, m_eligibility, m_rng);
+                double   fitness   = m_evaluator.evaluate(candidate);
+                if (fitness > bestFitness) {
+                    best        = std::move(candidate);
+                    bestFitness = fitness;
                 }
             }
 
-            return destinations;
+            Chromosome chromosome = Operators::toChromosome(best, m_eligibility);
+            Schedule   phenotype;
+            m_evaluator.evaluateAndUpdate(chromosome, phenotype, m_lotIds, m_machineIds);
+            return {chromosome, phenotype};
         }
 
-        void buildMigrationTopology() override
+        double getBestFitness() const
         {
-            // 构建迁移拓扑矩阵
-            m_topologyMatrix.resize(m_numIslands, std::vector<bool>(m_numIslands, false));
-
-            // 根据迁移拓扑设置连接关系
-            switch (m_migrationTopology) {
-                case algorithm::MigrationTopology::RING:
-                    // 环形拓扑：每个岛只与相邻岛连接
-                    for (size_t i = 0; i < m_numIslands; ++i) {
-                        m_topologyMatrix[i][(i + 1) % m_numIslands]                = true;
-                        m_topologyMatrix[i][(i + m_numIslands - 1) % m_numIslands] = true;
-                    }
-                    break;
-
-                case algorithm::MigrationTopology::FULLY_CONNECTED:
-                    // 全连接拓扑：每个岛与所有其他岛连接
-                    for (size_t i = 0; i < m_numIslands; ++i) {
-                        for (size_t j = 0; j < m_numIslands; ++j) {
-                            if (i != j) {
-                                m_topologyMatrix[i][j] = true;
-                            }
-                        }
-                    }
-                    break;
-
-                case algorithm::MigrationTopology::STAR:
-                    // 星形拓扑：中心岛(0)与所有其他岛连接
-                    for (size_t i = 1; i < m_numIslands; ++i) {
-                        m_topologyMatrix[0][i] = true;
-                        m_topologyMatrix[i][0] = true;
-                    }
-                    break;
-
-                case algorithm::MigrationTopology::MESH:
-                    // 网格拓扑：每个岛与一定范围内的岛连接
-                    size_t meshSize = static_cast<size_t>(std::sqrt(m_numIslands));
-                    for (size_t i = 0; i < m_numIslands; ++i) {
-                        size_t row = i / meshSize;
-                        size_t col = i % meshSize;
-
-                        // 连接上下左右的邻居
-                        if (row > 0) m_topologyMatrix[i][i - meshSize] = true;
-                        if (row < meshSize - 1) m_topologyMatrix[i][i + meshSize] = true;
-                        if (col > 0) m_topologyMatrix[i][i - 1] = true;
-                        if (col < meshSize - 1) m_topologyMatrix[i][i + 1] = true;
-                    }
-                    break;
-            }
+            return m_engine->bestFitness();
         }
 
     private:
         // 参数
+        size_t                           m_numIslands;
+        size_t                           m_populationPerIsland;
         size_t                           m_lotCount;
         size_t                           m_machineCount;
         std::vector<std::vector<double>> m_processingTimes;
@@ -240,134 +384,297 @@ class JobSchedulerImpl::SchedulerGA: public algorithm::ArchipelagoGA<Chromosome,
         double                           m_crossoverRate;
         double                           m_mutationRate;
         size_t                           m_elitismCount;
+        size_t                           m_migrationInterval = 10;
+        double                           m_migrationRate     = 0.1;
+        size_t                           m_threadCount       = 0;
+        size_t                           m_offspringChunk    = 0;
+        bool                             m_pinThreads        = false;
 
-        // 随机数生成
+        // 随机数生成（初始种群和各岛随机数种子）
         std::mt19937 m_rng;
 
-        // 种群和适应度
-        std::vector<std::vector<Chromosome>> m_populations;
-        std::vector<std::vector<double>>     m_fitness;
-
-        // 最优解
-        Chromosome m_bestChromosome;
-        Schedule   m_bestPhenotype;
-        double     m_bestFitness;
+        // 批次的可加工机台
+        EligibilityTable m_eligibility;
 
         // 评估器
         ScheduleEvaluator m_evaluator;
 
+        // 演化引擎
+        std::unique_ptr<Engine> m_engine;
+
+        // 增量重调度的种子个体
+        Genotype m_seedChromosome;
+        bool     m_hasSeed = false;
+
+        // 进程间迁移通道
+        std::shared_ptr<MigrationTransport> m_transport;
+
+        // 检查点
+        std::string m_checkpointPath;
+        size_t      m_checkpointInterval = 0;
+        bool        m_checkpointRestore  = false;
+
+        // 求解进度
+        ProgressCallback                      m_progressCallback;
+        std::chrono::steady_clock::time_point m_startTime;
+
+        // 遥测
+        TelemetryCallback                     m_telemetryCallback;
+        std::vector<PhaseTimes>               m_islandPhases;
+        PhaseTimes                            m_mainPhases;
+        std::chrono::steady_clock::time_point m_lastTelemetryTime;
+        size_t                                m_lastTelemetryEvals = 0;
+
         /**
-         * 演化单个岛
+         * 与其他进程交换移民
+         * 每个岛按迁移率选出移民发送，收到的移民轮流分配给本地各岛
          */
-        void evolveIsland(size_t island)
+        void exchangeRemoteMigrants()
         {
-            // 创建新一代种群
-            std::vector<Chromosome> newPopulation;
-            std::vector<double>     newFitness;
-
-            // 精英保留
-            std::vector<std::pair<double, size_t>> sortedIndices;
-            for (size_t i = 0; i < m_populationPerIsland; ++i) {
-                sortedIndices.push_back({m_fitness[island][i], i});
+            const size_t migrantCount = m_engine->migrantCount();
+
+            std::vector<Chromosome> emigrants;
+            for (size_t island = 0; island < m_numIslands; ++island) {
+                for (const auto &migrant: m_engine->selectMigrants(island, migrantCount)) {
+                    emigrants.push_back(Operators::toChromosome(migrant, m_eligibility));
+                }
             }
-            std::sort(sortedIndices.begin(), sortedIndices.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
 
-            // 复制精英到新种群
-            for (size_t i = 0; i < m_elitismCount && i < sortedIndices.size(); ++i) {
-                size_t idx = sortedIndices[i].second;
-                newPopulation.push_back(m_populations[island][idx]);
-                newFitness.push_back(m_fitness[island][idx]);
+            std::vector<Chromosome> immigrants = m_transport->exchangeMigrants(emigrants);
+            for (size_t i = 0; i < immigrants.size(); ++i) {
+                // 转换时修复，避免异常数据破坏种群
+                m_engine->acceptMigrant(i % m_numIslands, Operators::fromChromosome(immigrants[i], m_eligibility, m_rng));
+            }
+        }
+
+        /**
+         * 报告求解进度
+         */
+        void reportProgress(size_t generation)
+        {
+            if (m_telemetryCallback) {
+                reportTelemetry(generation);
             }
 
-            // 通过选择、交叉和变异生成剩余个体
-            while (newPopulation.size() < m_populationPerIsland) {
-                // 选择两个父代
-                size_t parent1Idx = tournamentSelect(island);
-                size_t parent2Idx = tournamentSelect(island);
+            if (!m_progressCallback) {
+                return;
+            }
 
-                // 交叉
-                Chromosome child1 = m_populations[island][parent1Idx];
-                Chromosome child2 = m_populations[island][parent2Idx];
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_startTime;
+            m_progressCallback({generation, m_engine->evaluations(), -m_engine->bestFitness(), elapsed.count()});
+        }
 
-                if (std::uniform_real_distribution<double>(0.0, 1.0)(m_rng) < m_crossoverRate) {
-                    child1 = child1.crossover(m_populations[island][parent2Idx], m_rng);
-                    child2 = child2.crossover(m_populations[island][parent1Idx], m_rng);
-                }
+        /**
+         * 汇总并报告本代遥测数据，随后清零阶段计时
+         */
+        void reportTelemetry(size_t generation)
+        {
+            auto   now         = std::chrono::steady_clock::now();
+            size_t evaluations = m_engine->evaluations();
+            double interval    = std::chrono::duration<double>(now - m_lastTelemetryTime).count();
 
-                // 变异
-                child1.mutate(m_mutationRate, m_rng);
-                child2.mutate(m_mutationRate, m_rng);
+            GenerationStats stats;
+            stats.generation           = generation;
+            stats.elapsedSeconds       = std::chrono::duration<double>(now - m_startTime).count();
+            stats.evaluations          = evaluations;
+            stats.evaluationsPerSecond = interval > 0 ? (evaluations - m_lastTelemetryEvals) / interval : 0.0;
+            stats.bestMakespan         = -m_engine->bestFitness();
 
-                // 修复无效染色体
-                child1.repair(m_lotCount, m_machineCount, m_processingTimes, m_rng);
-                child2.repair(m_lotCount, m_machineCount, m_processingTimes, m_rng);
+            for (size_t island = 0; island < m_numIslands; ++island) {
+                stats.islands.push_back(computeIslandStats(island));
+
+                const PhaseTimes &phases = m_islandPhases[island];
+                stats.phases.selection += phases.selection;
+                stats.phases.crossover += phases.crossover;
+                stats.phases.mutation += phases.mutation;
+                stats.phases.repair += phases.repair;
+                stats.phases.evaluation += phases.evaluation;
+            }
+            stats.phases.migration = m_mainPhases.migration;
 
-                // 评估新个体
-                double fitness1 = m_evaluator.evaluate(child1);
-                double fitness2 = m_evaluator.evaluate(child2);
+            m_islandPhases.assign(m_numIslands, PhaseTimes());
+            m_mainPhases         = PhaseTimes();
+            m_lastTelemetryTime  = now;
+            m_lastTelemetryEvals = evaluations;
 
-                // 添加到新种群
-                newPopulation.push_back(child1);
-                newFitness.push_back(fitness1);
+            m_telemetryCallback(stats);
+        }
 
-                if (newPopulation.size() < m_populationPerIsland) {
-                    newPopulation.push_back(child2);
-                    newFitness.push_back(fitness2);
+        /**
+         * 计算岛的适应度统计和多样性
+         * 多样性按批次的机台分配计算，与机台内顺序无关
+         */
+        IslandStats computeIslandStats(size_t island) const
+        {
+            const auto &population = m_engine->population(island);
+            const auto &fitness    = m_engine->fitness(island);
+
+            IslandStats stats {fitness[0], 0.0, fitness[0], 0.0};
+            size_t      bestIdx = 0;
+            for (size_t i = 0; i < fitness.size(); ++i) {
+                stats.meanFitness += fitness[i];
+                stats.worstFitness = std::min(stats.worstFitness, fitness[i]);
+                if (fitness[i] > stats.bestFitness) {
+                    stats.bestFitness = fitness[i];
+                    bestIdx           = i;
                 }
+            }
+            stats.meanFitness /= fitness.size();
+
+            // 岛内最优个体中每个批次的机台
+            std::vector<size_t> bestMachine = Operators::assignmentOf(population[bestIdx], m_eligibility);
 
-                // 更新全局最佳解
-                if (fitness1 > m_bestFitness) {
-                    m_bestFitness    = fitness1;
-                    m_bestChromosome = child1;
+            for (size_t i = 0; i < population.size(); ++i) {
+                if (i == bestIdx) {
+                    continue;
+                }
 
-                    // 更新最佳解的表现型
-                    m_bestPhenotype.clear();
-                    m_evaluator.evaluateAndUpdate(
-                      m_bestChromosome, m_bestPhenotype, m_lotIds, m_machineIds);
+                std::vector<size_t> machine   = Operators::assignmentOf(population[i], m_eligibility);
+                size_t              differing = 0;
+                for (size_t lot = 0; lot < m_lotCount; ++lot) {
+                    if (machine[lot] < m_machineCount && machine[lot] != bestMachine[lot]) {
+                        ++differing;
+                    }
                 }
+                stats.diversity += static_cast<double>(differing) / m_lotCount;
+            }
+            if (population.size() > 1) {
+                stats.diversity /= population.size() - 1;
+            }
+
+            return stats;
+        }
 
-                if (fitness2 > m_bestFitness) {
-                    m_bestFitness    = fitness2;
-                    m_bestChromosome = child2;
+        /**
+         * 写入检查点
+         */
+        void saveCheckpoint()
+        {
+            RTD_PROBE_SCOPE("ga.checkpoint");
 
-                    // 更新最佳解的表现型
-                    m_bestPhenotype.clear();
-                    m_evaluator.evaluateAndUpdate(
-                      m_bestChromosome, m_bestPhenotype, m_lotIds, m_machineIds);
+            GACheckpoint checkpoint;
+            checkpoint.fingerprint    = GACheckpoint::fingerprintOf(m_lotIds, m_machineIds, m_processingTimes);
+            checkpoint.generation     = m_engine->generation();
+            checkpoint.lotIds         = m_lotIds;
+            checkpoint.machineIds     = m_machineIds;
+            checkpoint.bestChromosome = Operators::toChromosome(m_engine->best(), m_eligibility);
+            checkpoint.bestFitness    = m_engine->bestFitness();
+
+            // 检查点统一按基因编码保存
+            for (size_t island = 0; island < m_numIslands; ++island) {
+                checkpoint.populations.emplace_back();
+                for (const auto &individual: m_engine->population(island)) {
+                    checkpoint.populations.back().push_back(Operators::toChromosome(individual, m_eligibility));
                 }
+                checkpoint.fitness.emplace_back(m_engine->fitness(island).begin(), m_engine->fitness(island).end());
+                checkpoint.rngs.push_back(m_engine->rng(island));
             }
 
-            // 更新种群
-            m_populations[island] = std::move(newPopulation);
-            m_fitness[island]     = std::move(newFitness);
+            if (!checkpoint.write(m_checkpointPath)) {
+                std::cerr << "写入遗传算法检查点失败: " << m_checkpointPath << std::endl;
+            }
         }
 
         /**
-         * 锦标赛选择
+         * 从检查点恢复种群
+         * 问题指纹和种群结构完全一致时原样恢复（含随机数状态）；
+         * 否则按批次ID和机台ID重映射基因，修复后重新评估，至少一半当前批次出现在检查点中才使用
+         * @return 是否已恢复
          */
-        size_t tournamentSelect(size_t island)
+        bool restoreCheckpoint()
         {
-            static const size_t TOURNAMENT_SIZE = 3;
+            GACheckpoint checkpoint;
+            if (!checkpoint.read(m_checkpointPath)) {
+                return false;
+            }
+
+            uint64_t fingerprint = GACheckpoint::fingerprintOf(m_lotIds, m_machineIds, m_processingTimes);
+            bool     sameShape   = checkpoint.populations.size() == m_numIslands && !checkpoint.populations.empty() && checkpoint.populations[0].size() == m_populationPerIsland;
+
+            if (checkpoint.fingerprint == fingerprint && sameShape) {
+                std::vector<std::vector<Genotype>> populations(m_numIslands);
+                for (size_t island = 0; island < m_numIslands; ++island) {
+                    for (const auto &chromosome: checkpoint.populations[island]) {
+                        populations[island].push_back(Operators::fromChromosome(chromosome, m_eligibility, m_rng));
+                    }
+                }
 
-            std::uniform_int_distribution<size_t> dist(0, m_populationPerIsland - 1);
+                size_t generation = checkpoint.generation;
+                m_engine->restore(std::move(populations), std::move(checkpoint.fitness), std::move(checkpoint.rngs), generation);
 
-            size_t bestIdx     = dist(m_rng);
-            double bestFitness = m_fitness[island][bestIdx];
+                std::cout << "从检查点恢复种群（第 " << generation << " 代）" << std::endl;
+                return true;
+            }
 
-            for (size_t i = 1; i < TOURNAMENT_SIZE; ++i) {
-                size_t idx = dist(m_rng);
-                if (m_fitness[island][idx] > bestFitness) {
-                    bestIdx     = idx;
-                    bestFitness = m_fitness[island][idx];
+            // 旧索引到新索引的映射
+            std::unordered_map<std::string, size_t> lotIndexMap;
+            for (size_t i = 0; i < m_lotCount; ++i) {
+                lotIndexMap[m_lotIds[i]] = i;
+            }
+            std::unordered_map<std::string, size_t> machineIndexMap;
+            for (size_t j = 0; j < m_machineCount; ++j) {
+                machineIndexMap[m_machineIds[j]] = j;
+            }
+
+            const size_t        oldMachineCount = checkpoint.machineIds.size();
+            std::vector<size_t> lotMap(checkpoint.lotIds.size(), m_lotCount);
+            std::vector<size_t> machineMap(oldMachineCount, m_machineCount);
+            size_t              sharedLots = 0;
+
+            for (size_t i = 0; i < checkpoint.lotIds.size(); ++i) {
+                auto it = lotIndexMap.find(checkpoint.lotIds[i]);
+                if (it != lotIndexMap.end()) {
+                    lotMap[i] = it->second;
+                    ++sharedLots;
                 }
             }
+            for (size_t j = 0; j < oldMachineCount; ++j) {
+                auto it = machineIndexMap.find(checkpoint.machineIds[j]);
+                if (it != machineIndexMap.end()) {
+                    machineMap[j] = it->second;
+                }
+            }
+
+            if (oldMachineCount == 0 || sharedLots * 2 < m_lotCount) {
+                return false;    // 问题变化过大，检查点已无参考价值
+            }
 
-            return bestIdx;
+            std::vector<Chromosome> restored;
+            for (const auto &population: checkpoint.populations) {
+                for (const auto &chromosome: population) {
+                    std::vector<size_t> genes;
+                    genes.reserve(m_lotCount);
+                    for (size_t gene: chromosome.getGenes()) {
+                        size_t lot     = gene / oldMachineCount;
+                        size_t machine = gene % oldMachineCount;
+                        if (lot >= lotMap.size() || lotMap[lot] == m_lotCount || machineMap[machine] == m_machineCount) {
+                            continue;    // 批次已完成或机台已不存在
+                        }
+                        genes.push_back(lotMap[lot] * m_machineCount + machineMap[machine]);
+                    }
+                    restored.emplace_back(genes);
+                }
+            }
+
+            // 依次填充各岛，不足部分用随机个体补齐；修复会补入新增批次并剔除不兼容的分配。
+            // 与冷启动一样按岛并行转换和评估，代数从0重新计数
+            m_engine->initialize(
+              [this, &restored](size_t island, size_t i, std::mt19937 &rng) {
+                  size_t index = island * m_populationPerIsland + i;
+                  if (index < restored.size()) {
+                      return Operators::fromChromosome(restored[index], m_eligibility, rng);
+                  }
+                  return Operators::createRandom(m_eligibility, rng);
+              },
+              m_rng);
+
+            std::cout << "从检查点重映射种群：" << sharedLots << "/" << m_lotCount << " 个批次沿用" << std::endl;
+            return true;
         }
 };
 
 JobSchedulerImpl::JobSchedulerImpl()
-    : m_populationSize(100), m_generationCount(200), m_islandCount(4), m_crossoverRate(0.8), m_mutationRate(0.2), m_elitismCount(2), m_migrationInterval(10), m_migrationRate(0.1)
+    : m_populationSize(100), m_generationCount(200), m_islandCount(4), m_crossoverRate(0.8), m_mutationRate(0.2), m_elitismCount(2), m_migrationInterval(10), m_migrationRate(0.1), m_threadCount(0), m_offspringChunk(0), m_pinThreads(false), m_encoding(ChromosomeEncoding::PERMUTATION), m_hasInitialSchedule(false), m_checkpointInterval(0), m_checkpointRestore(false)
 {
     // 使用时间种子初始化随机数生成器
     unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
@@ -421,6 +728,24 @@ bool JobSchedulerImpl::setProcessingTime(size_t lotIndex, size_t machineIndex, d
     return true;
 }
 
+void JobSchedulerImpl::setMigrationTransport(std::shared_ptr<MigrationTransport> transport)
+{
+    m_transport = std::move(transport);
+}
+
+void JobSchedulerImpl::setCheckpoint(const std::string &path, size_t interval, bool restore)
+{
+    m_checkpointPath     = path;
+    m_checkpointInterval = interval;
+    m_checkpointRestore  = restore;
+}
+
+void JobSchedulerImpl::setInitialSchedule(const Schedule &schedule)
+{
+    m_initialSchedule    = schedule;
+    m_hasInitialSchedule = true;
+}
+
 Schedule JobSchedulerImpl::calculateSchedule()
 {
     validateInputs();
@@ -429,8 +754,20 @@ Schedule JobSchedulerImpl::calculateSchedule()
         return Schedule();
     }
 
+    switch (m_encoding) {
+        case ChromosomeEncoding::TWO_PART:
+            return solve<TwoPartChromosome>();
+        case ChromosomeEncoding::PERMUTATION:
+        default:
+            return solve<Chromosome>();
+    }
+}
+
+template<typename Genotype>
+Schedule JobSchedulerImpl::solve()
+{
     // 创建并配置遗传算法
-    SchedulerGA ga(
+    SchedulerGA<Genotype> ga(
       m_islandCount,
       m_populationSize / m_islandCount,
       m_lotIds.size(),
@@ -440,18 +777,62 @@ Schedule JobSchedulerImpl::calculateSchedule()
       m_machineIds,
       m_crossoverRate,
       m_mutationRate,
-      m_elitismCount);
+      m_elitismCount,
+      static_cast<unsigned>(m_rng()));
 
     // 设置迁移参数
     ga.setMigrationInterval(m_migrationInterval);
     ga.setMigrationRate(m_migrationRate);
 
+    ga.setThreadCount(m_threadCount);
+    ga.setOffspringChunkSize(m_offspringChunk);
+    ga.setThreadAffinity(m_pinThreads);
+    if (m_progressCallback) {
+        ga.setProgressCallback(m_progressCallback);
+    }
+    if (m_telemetryCallback) {
+        ga.setTelemetryCallback(m_telemetryCallback);
+    }
+
+    if (!m_checkpointPath.empty()) {
+        ga.setCheckpoint(m_checkpointPath, m_checkpointInterval, m_checkpointRestore);
+    }
+
+    // 增量重调度：以修复后的上一版方案作为种子
+    if (m_hasInitialSchedule) {
+        ga.setSeedChromosome(buildSeedChromosome());
+    }
+
+    // 分布式求解：广播问题给其他进程
+    if (m_transport) {
+        m_transport->beginRun({m_islandCount,
+                               m_populationSize / m_islandCount,
+                               m_generationCount,
+                               m_migrationInterval,
+                               m_migrationRate,
+                               m_crossoverRate,
+                               m_mutationRate,
+                               m_elitismCount,
+                               m_lotIds.size(),
+                               m_machineIds.size(),
+                               &m_processingTimes,
+                               m_encoding});
+        ga.setMigrationTransport(m_transport);
+    }
+
     // 初始化并运行算法
     ga.initialize();
     ga.evolve(m_generationCount);
 
     // 返回最佳解
     auto solution = ga.getBestSolution();
+
+    // 汇总所有进程的全局最优解
+    if (m_transport) {
+        std::vector<Chromosome> remoteResults = m_transport->finishRun(solution.first, ga.getBestFitness());
+        return ga.getBestSolution(remoteResults).second;
+    }
+
     return solution.second;
 }
 
@@ -510,6 +891,110 @@ Schedule JobSchedulerImpl::decodeChromosome(const Chromosome &chromosome)
     return schedule;
 }
 
+Chromosome JobSchedulerImpl::buildSeedChromosome() const
+{
+    const size_t lotCount     = m_lotIds.size();
+    const size_t machineCount = m_machineIds.size();
+
+    std::unordered_map<std::string, size_t> lotIndexMap;
+    for (size_t i = 0; i < lotCount; ++i) {
+        lotIndexMap[m_lotIds[i]] = i;
+    }
+
+    std::unordered_map<std::string, size_t> machineIndexMap;
+    for (size_t j = 0; j < machineCount; ++j) {
+        machineIndexMap[m_machineIds[j]] = j;
+    }
+
+    std::vector<size_t> genes;
+    std::vector<bool>   placed(lotCount, false);
+    std::vector<double> machineLoads(machineCount, 0.0);
+
+    // 保留仍然有效的分配，机台内顺序不变
+    for (const auto &machineJobs: m_initialSchedule.machineAssignments) {
+        for (const auto &job: machineJobs) {
+            auto lotIt     = lotIndexMap.find(job.lotId);
+            auto machineIt = machineIndexMap.find(job.machineId);
+            if (lotIt == lotIndexMap.end() || machineIt == machineIndexMap.end()) {
+                continue;    // 批次已完成或机台已不存在
+            }
+
+            size_t lot     = lotIt->second;
+            size_t machine = machineIt->second;
+            if (placed[lot] || m_processingTimes[lot][machine] <= 0) {
+                continue;    // 机台停机或工艺不再兼容
+            }
+
+            genes.push_back(lot * machineCount + machine);
+            placed[lot] = true;
+            machineLoads[machine] += m_processingTimes[lot][machine];
+        }
+    }
+
+    // 新增及失效的批次按最短处理时间从大到小排序(LPT)，依次插入最早完工的机台队尾
+    std::vector<std::pair<double, size_t>> unplaced;
+    for (size_t lot = 0; lot < lotCount; ++lot) {
+        if (placed[lot]) {
+            continue;
+        }
+
+        double minTime = std::numeric_limits<double>::max();
+        for (size_t machine = 0; machine < machineCount; ++machine) {
+            if (m_processingTimes[lot][machine] > 0) {
+                minTime = std::min(minTime, m_processingTimes[lot][machine]);
+            }
+        }
+
+        if (minTime < std::numeric_limits<double>::max()) {
+            unplaced.push_back({minTime, lot});
+        }
+    }
+    std::sort(unplaced.begin(), unplaced.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+
+    for (const auto &[minTime, lot]: unplaced) {
+        size_t bestMachine = machineCount;
+        double bestEnd     = std::numeric_limits<double>::max();
+
+        for (size_t machine = 0; machine < machineCount; ++machine) {
+            double time = m_processingTimes[lot][machine];
+            if (time > 0 && machineLoads[machine] + time < bestEnd) {
+                bestEnd     = machineLoads[machine] + time;
+                bestMachine = machine;
+            }
+        }
+
+        genes.push_back(lot * machineCount + bestMachine);
+        machineLoads[bestMachine] = bestEnd;
+    }
+
+    return Chromosome(genes);
+}
+
+bool parseChromosomeEncoding(const std::string &name, ChromosomeEncoding &encoding)
+{
+    if (name == "permutation") {
+        encoding = ChromosomeEncoding::PERMUTATION;
+    }
+    else if (name == "two_part") {
+        encoding = ChromosomeEncoding::TWO_PART;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+const char *chromosomeEncodingName(ChromosomeEncoding encoding)
+{
+    switch (encoding) {
+        case ChromosomeEncoding::TWO_PART:
+            return "two_part";
+        case ChromosomeEncoding::PERMUTATION:
+        default:
+            return "permutation";
+    }
+}
+
 std::unique_ptr<JobScheduler> JobScheduler::create()
 {
     return std::make_unique<JobSchedulerImpl>();
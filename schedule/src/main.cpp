@@ -1,8 +1,17 @@
+#include "dispatch_plan_publisher.h"
+#include "dispatch_writer.h"
+#include "distributed_islands.h"
 #include "job_scheduler.h"
+#include "problem_snapshot.h"
+#include "schedule_config.h"
 #include "schedule_data_manager.h"
+#include "schedule_event_listener.h"
+#include "schedule_probe.h"
+#include "schedule_problem.h"
 #include <atomic>
 #include <chrono>
 #include <csignal>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -13,6 +22,12 @@ using namespace rtd::schedule;
 // 全局变量用于处理信号
 std::atomic<bool> g_running{true};
 
+// 每代遥测输出（未启用时为空）
+std::unique_ptr<TelemetryJsonLinesWriter> g_telemetryWriter;
+
+// 进程启动后的第一次全量求解从检查点恢复，之后置为false
+bool g_restoreCheckpoint = true;
+
 // 信号处理函数
 void signalHandler(int signal)
 {
@@ -30,6 +45,257 @@ std::string getCurrentTimestamp()
     return ss.str();
 }
 
+// 设置调度参数
+void configureScheduler(JobScheduler &scheduler, size_t generations, const ScheduleConfig &config)
+{
+    scheduler.setPopulationSize(100);
+    scheduler.setGenerationCount(generations);
+    scheduler.setIslandCount(4);
+    scheduler.setCrossoverRate(0.8);
+    scheduler.setMutationRate(0.2);
+    scheduler.setElitismCount(2);
+    scheduler.setMigrationInterval(10);
+    scheduler.setMigrationRate(0.1);
+    scheduler.setEncoding(config.ga.encoding);
+    scheduler.setThreadCount(config.ga.threads);
+    scheduler.setOffspringChunkSize(config.ga.offspringChunk);
+    scheduler.setThreadAffinity(config.ga.pinThreads);
+
+    if (g_telemetryWriter) {
+        scheduler.setTelemetryCallback(g_telemetryWriter->callback());
+    }
+}
+
+// 输出本轮插桩探针统计并导出trace（仅在编译时启用RTD_SCHEDULE_PROFILE时有数据）
+void exportProbes(const ScheduleConfig &config)
+{
+    if constexpr (probe::kEnabled) {
+        probe::printSummary(std::cout);
+        if (probe::exportChromeTrace(config.profile.tracePath)) {
+            std::cout << "插桩trace已导出: " << config.profile.tracePath << std::endl;
+        }
+        probe::reset();
+    }
+}
+
+// 预取的主数据快照及其加载耗时
+struct PrefetchedSnapshot {
+        MasterDataSnapshot snapshot;
+        double             loadSeconds = 0.0;
+};
+
+/**
+ * 加载下一轮全量调度的主数据
+ * 流水线模式下在后台线程加载，与求解、等待重叠；否则推迟到get()时在调用线程上加载。
+ * recordPath非空时把加载的主数据录制为问题快照文件
+ */
+std::future<PrefetchedSnapshot> loadSnapshot(ScheduleDataManager &dataManager, bool fullReload, bool pipelined, std::string recordPath)
+{
+    auto policy = pipelined ? std::launch::async : std::launch::deferred;
+    return std::async(policy, [&dataManager, fullReload, recordPath = std::move(recordPath)]() {
+        auto start = std::chrono::steady_clock::now();
+
+        PrefetchedSnapshot loaded;
+        loaded.snapshot = dataManager.refreshSnapshot(fullReload);
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        loaded.loadSeconds                    = elapsed.count();
+
+        if (!recordPath.empty() && !writeProblemSnapshot(recordPath, loaded.snapshot)) {
+            std::cerr << "录制问题快照失败: " << recordPath << std::endl;
+        }
+        return loaded;
+    });
+}
+
+// 发布并保存调度方案
+void publishSchedule(
+  const Schedule                 &schedule,
+  const std::vector<std::string> &equipments,
+  DispatchWriter                 &writer,
+  DispatchPlanPublisher          *planPublisher)
+{
+    double releaseTime = static_cast<double>(std::chrono::system_clock::to_time_t(
+      std::chrono::system_clock::now()));
+
+    // 先发布到内存派工计划，服务端无需等待数据库写入即可查询
+    if (planPublisher && !schedule.assignments.empty()) {
+        if (planPublisher->publish(schedule, equipments, releaseTime)) {
+            std::cout << "派工计划已发布到内存索引" << std::endl;
+        }
+        else {
+            std::cerr << "发布内存派工计划失败" << std::endl;
+        }
+    }
+
+    // 保存调度结果到数据库
+    std::cout << "保存调度结果到数据库..." << std::endl;
+
+    // 如果找到了有效的调度方案
+    if (!schedule.assignments.empty()) {
+        std::vector<std::tuple<std::string, std::string, double, double, double>> results;
+
+        // 对每个机台处理分配的批次
+        for (size_t i = 0; i < schedule.machineAssignments.size(); ++i) {
+            const auto &machineJobs = schedule.machineAssignments[i];
+            std::string equipmentId = i < equipments.size() ? equipments[i] : "Unknown";
+
+            for (const auto &job: machineJobs) {
+                // 确保处理时间大于0（有效配置）
+                if (job.processingTime > 0) {
+                    results.push_back(std::make_tuple(
+                      equipmentId,
+                      job.lotId,
+                      releaseTime,
+                      job.startTime,
+                      job.endTime));
+                }
+            }
+        }
+
+        if (!results.empty()) {
+            // 由写入器在后台写入，不阻塞下一阶段
+            writer.submit(std::move(results), releaseTime);
+        }
+        else {
+            std::cout << "没有找到有效的调度方案" << std::endl;
+        }
+    }
+    else {
+        std::cout << "没有找到有效的调度方案" << std::endl;
+    }
+}
+
+// 全量调度：用已加载的主数据快照从头计算
+bool runFullCycle(
+  const ScheduleConfig                     &config,
+  MasterDataSnapshot                        snapshot,
+  DispatchWriter                           &writer,
+  DispatchPlanPublisher                    *planPublisher,
+  const std::shared_ptr<IslandCoordinator> &coordinator,
+  ScheduleProblem                          &problem,
+  Schedule                                 &currentSchedule)
+{
+    std::vector<std::string> equipments = std::move(snapshot.equipments);
+    std::vector<std::string> lots       = std::move(snapshot.lots);
+
+    std::cout << "发现 " << equipments.size() << " 台设备和 " << lots.size() << " 个批次" << std::endl;
+
+    if (equipments.empty() || lots.empty()) {
+        std::cout << "没有找到设备或批次，等待下一轮调度" << std::endl;
+        return false;
+    }
+
+    std::vector<std::vector<double>> processingTimes = std::move(snapshot.processingTimes);
+
+    // 输出工艺兼容性信息
+    int compatiblePairs = 0;
+    for (size_t i = 0; i < lots.size(); ++i) {
+        for (size_t j = 0; j < equipments.size(); ++j) {
+            if (processingTimes[i][j] > 0) {
+                compatiblePairs++;
+            }
+        }
+    }
+    std::cout << "工艺兼容性：" << compatiblePairs << " 个有效配对（非零处理时间）" << std::endl;
+
+    problem.reset(lots, equipments, processingTimes);
+
+    // 创建调度器
+    auto scheduler = JobScheduler::create();
+    scheduler->setLots(lots);
+    scheduler->setMachines(equipments);
+    scheduler->setProcessingTimes(processingTimes);
+
+    // 设置调度参数
+    configureScheduler(*scheduler, 200, config);
+
+    // 检查点只用于全量求解：重启后的第一次求解从中恢复，增量细化的短时求解既不恢复也不覆盖
+    if (config.checkpoint.enabled) {
+        scheduler->setCheckpoint(config.checkpoint.path, config.checkpoint.intervalGenerations, g_restoreCheckpoint);
+        g_restoreCheckpoint = false;
+    }
+
+    // 有工作进程连接时，岛屿分布到多个进程求解
+    if (coordinator && coordinator->getWorkerCount() > 0) {
+        scheduler->setMigrationTransport(coordinator);
+    }
+
+    std::cout << "开始计算调度方案..." << std::endl;
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // 计算调度方案
+    Schedule schedule = scheduler->calculateSchedule();
+
+    auto                          endTime = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = endTime - startTime;
+
+    std::cout << "调度计算完成，耗时 " << elapsed.count() << " 秒" << std::endl;
+    std::cout << "完工时间: " << schedule.makespan << std::endl;
+    std::cout << "平均流通时间: " << schedule.meanFlowTime << std::endl;
+
+    publishSchedule(schedule, equipments, writer, planPublisher);
+
+    currentSchedule = std::move(schedule);
+    return true;
+}
+
+// 增量调度：把事件应用到当前问题，修复上一版方案后做短时GA细化
+void runIncrementalCycle(
+  std::vector<ScheduleEvent> &events,
+  const ScheduleConfig       &config,
+  ScheduleDataManager        &dataManager,
+  DispatchWriter             &writer,
+  DispatchPlanPublisher      *planPublisher,
+  ScheduleProblem            &problem,
+  Schedule                   &currentSchedule)
+{
+    const auto &equipments = problem.getMachineIds();
+    size_t      applied    = 0;
+
+    for (auto &event: events) {
+        // 新批次未携带处理时间时，从数据源一次查询该批次在各设备上的处理时间
+        if (event.type == ScheduleEventType::LOT_ARRIVED && event.processTimes.empty() && !problem.hasLot(event.lotId)) {
+            event.processTimes = dataManager.getProcessTimesByLot(event.lotId, equipments);
+        }
+
+        if (problem.apply(event)) {
+            ++applied;
+        }
+    }
+
+    std::cout << "收到 " << events.size() << " 个调度事件，其中 " << applied << " 个改变了调度问题" << std::endl;
+    if (applied == 0) {
+        return;
+    }
+
+    std::vector<std::string>         lots;
+    std::vector<std::vector<double>> processingTimes;
+    problem.exportSchedulable(lots, processingTimes);
+
+    if (lots.empty()) {
+        std::cout << "当前没有可调度的批次" << std::endl;
+        return;
+    }
+
+    auto scheduler = JobScheduler::create();
+    scheduler->setLots(lots);
+    scheduler->setMachines(equipments);
+    scheduler->setProcessingTimes(processingTimes);
+    configureScheduler(*scheduler, config.events.refineGenerations, config);
+    scheduler->setInitialSchedule(currentSchedule);
+
+    auto     startTime = std::chrono::high_resolution_clock::now();
+    Schedule schedule  = scheduler->calculateSchedule();
+
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+    std::cout << "增量调度完成，耗时 " << elapsed.count() << " 秒，完工时间: " << schedule.makespan << std::endl;
+
+    publishSchedule(schedule, equipments, writer, planPublisher);
+
+    currentSchedule = std::move(schedule);
+}
+
 int main(int argc, char *argv[])
 {
     try {
@@ -39,6 +305,21 @@ int main(int argc, char *argv[])
 
         std::cout << "RTD+ 调度引擎启动..." << std::endl;
 
+        // 工作进程模式: rtd_schedule --worker <host>:<port>
+        if (argc > 2 && std::string(argv[1]) == "--worker") {
+            std::string address = argv[2];
+            size_t      colon   = address.rfind(':');
+            if (colon == std::string::npos) {
+                std::cerr << "工作进程地址格式应为 host:port" << std::endl;
+                return 1;
+            }
+
+            ScheduleConfig config = ScheduleConfig::load();
+            IslandWorker   worker(address.substr(0, colon), std::stoi(address.substr(colon + 1)), config.distributed.timeoutSeconds);
+            std::cout << "以岛屿工作进程模式运行，协调进程: " << address << std::endl;
+            return worker.run(g_running);
+        }
+
         // 从命令行参数解析配置
         int scheduleIntervalSeconds = 300;    // 默认5分钟重新计算一次
 
@@ -48,133 +329,175 @@ int main(int argc, char *argv[])
 
         std::cout << "调度计算周期: " << scheduleIntervalSeconds << " 秒" << std::endl;
 
-        // 初始化数据管理器
-        auto dataManager = ScheduleDataManager::create();
+        // 加载运行配置
+        ScheduleConfig config = ScheduleConfig::load();
+
+        // 初始化数据管理器，配置了回放快照时不连接数据库
+        std::unique_ptr<ScheduleDataManager> dataManager;
+        if (config.snapshot.replayPath.empty()) {
+            dataManager = ScheduleDataManager::create();
+        }
+        else {
+            dataManager = ScheduleDataManager::createFromSnapshot(config.snapshot.replayPath);
+            std::cout << "从问题快照回放: " << config.snapshot.replayPath << std::endl;
+        }
+
         if (!dataManager->initialize()) {
             std::cerr << "数据管理器初始化失败" << std::endl;
             return 1;
         }
 
         std::cout << "数据管理器初始化成功" << std::endl;
+        dataManager->setDispatchBatchSize(config.dispatchWrite.batchSize);
+
+        if (!config.snapshot.recordPath.empty()) {
+            std::cout << "录制问题快照到: " << config.snapshot.recordPath << std::endl;
+        }
+
+        // 内存派工计划发布器
+        std::unique_ptr<DispatchPlanPublisher> planPublisher;
+        if (config.dispatchPlan.enabled) {
+            planPublisher = std::make_unique<DispatchPlanPublisher>(config.dispatchPlan.path);
+            std::cout << "派工计划发布路径: " << config.dispatchPlan.path << std::endl;
+        }
+
+        // 每代遥测输出
+        if (config.telemetry.enabled) {
+            g_telemetryWriter = std::make_unique<TelemetryJsonLinesWriter>(config.telemetry.path);
+            if (g_telemetryWriter->isOpen()) {
+                std::cout << "遗传算法遥测输出: " << config.telemetry.path << std::endl;
+            }
+            else {
+                std::cerr << "无法打开遥测输出文件 " << config.telemetry.path << "，不输出遥测" << std::endl;
+                g_telemetryWriter.reset();
+            }
+        }
+
+        // 调度事件监听器
+        std::unique_ptr<ScheduleEventListener> eventListener;
+        if (config.events.enabled) {
+            eventListener = std::make_unique<ScheduleEventListener>(
+              config.events.socketPath, std::chrono::milliseconds(config.events.debounceMs));
+            if (eventListener->start()) {
+                std::cout << "调度事件监听: " << config.events.socketPath << std::endl;
+            }
+            else {
+                std::cerr << "调度事件监听启动失败，仅按周期调度" << std::endl;
+                eventListener.reset();
+            }
+        }
+
+        // 分布式岛屿协调进程
+        std::shared_ptr<IslandCoordinator> coordinator;
+        if (config.distributed.enabled) {
+            coordinator = std::make_shared<IslandCoordinator>(config.distributed.listenPort, config.distributed.timeoutSeconds);
+            if (coordinator->start()) {
+                std::cout << "分布式岛屿协调端口: " << config.distributed.listenPort << std::endl;
+            }
+            else {
+                std::cerr << "分布式岛屿协调进程启动失败，仅使用本地岛屿" << std::endl;
+                coordinator.reset();
+            }
+        }
+
+        // 调度结果写入器，流水线模式下在后台线程写入
+        DispatchWriter writer(*dataManager, config.pipeline.enabled ? config.pipeline.writeQueue : 0, config.dispatchWrite.diff);
+        writer.start();
+
+        ScheduleProblem problem;
+        Schedule        currentSchedule;
+        bool            hasSchedule = false;
+        size_t          loads       = 0;
+
+        // 下一轮的主数据：流水线模式下在下一轮开始前提前加载
+        std::future<PrefetchedSnapshot> nextSnapshot;
+        double                          loadSeconds  = 0.0;    // 上一次加载耗时，用于安排预取时间
+        double                          cycleSeconds = 0.0;    // 上一轮加载加求解的耗时
+
+        auto startLoad = [&]() {
+            bool fullReload = config.snapshot.fullReloadCycles > 0 && loads % config.snapshot.fullReloadCycles == 0;
+            ++loads;
+            nextSnapshot = loadSnapshot(*dataManager, fullReload, config.pipeline.enabled, config.snapshot.recordPath);
+        };
 
         // 主调度循环
         while (g_running) {
             std::cout << "\n======== " << getCurrentTimestamp() << " 开始新一轮调度计算 ========" << std::endl;
+            auto cycleStart = std::chrono::steady_clock::now();
 
             try {
-                // 获取所有设备和批次
-                std::vector<std::string> equipments = dataManager->getAllEquipments();
-                std::vector<std::string> lots       = dataManager->getAllLots();
-
-                std::cout << "发现 " << equipments.size() << " 台设备和 " << lots.size() << " 个批次" << std::endl;
-
-                if (equipments.empty() || lots.empty()) {
-                    std::cout << "没有找到设备或批次，等待下一轮调度" << std::endl;
+                if (!nextSnapshot.valid()) {
+                    startLoad();
                 }
-                else {
-                    // 获取处理时间矩阵
-                    std::vector<std::vector<double>> processingTimes =
-                      dataManager->getProcessTimeMatrix(lots, equipments);
-
-                    std::cout << "处理时间矩阵加载完成" << std::endl;
-
-                    // 输出工艺兼容性信息
-                    int compatiblePairs = 0;
-                    for (size_t i = 0; i < lots.size(); ++i) {
-                        for (size_t j = 0; j < equipments.size(); ++j) {
-                            if (processingTimes[i][j] > 0) {
-                                compatiblePairs++;
-                            }
-                        }
-                    }
-                    std::cout << "工艺兼容性：" << compatiblePairs << " 个有效配对（非零处理时间）" << std::endl;
-
-                    // 创建调度器
-                    auto scheduler = JobScheduler::create();
-                    scheduler->setLots(lots);
-                    scheduler->setMachines(equipments);
-                    scheduler->setProcessingTimes(processingTimes);
-
-                    // 设置调度参数
-                    scheduler->setPopulationSize(100);
-                    scheduler->setGenerationCount(200);
-                    scheduler->setIslandCount(4);
-                    scheduler->setCrossoverRate(0.8);
-                    scheduler->setMutationRate(0.2);
-                    scheduler->setElitismCount(2);
-                    scheduler->setMigrationInterval(10);
-                    scheduler->setMigrationRate(0.1);
-
-                    std::cout << "开始计算调度方案..." << std::endl;
-                    auto startTime = std::chrono::high_resolution_clock::now();
-
-                    // 计算调度方案
-                    Schedule schedule = scheduler->calculateSchedule();
-
-                    auto                          endTime = std::chrono::high_resolution_clock::now();
-                    std::chrono::duration<double> elapsed = endTime - startTime;
-
-                    std::cout << "调度计算完成，耗时 " << elapsed.count() << " 秒" << std::endl;
-                    std::cout << "完工时间: " << schedule.makespan << std::endl;
-                    std::cout << "平均流通时间: " << schedule.meanFlowTime << std::endl;
-
-                    // 保存调度结果到数据库
-                    std::cout << "保存调度结果到数据库..." << std::endl;
-
-                    // 如果找到了有效的调度方案
-                    if (!schedule.assignments.empty()) {
-                        std::vector<std::tuple<std::string, std::string, double, double, double>> results;
-                        double                                                                    releaseTime = static_cast<double>(std::chrono::system_clock::to_time_t(
-                          std::chrono::system_clock::now()));
-
-                        // 对每个机台处理分配的批次
-                        for (size_t i = 0; i < schedule.machineAssignments.size(); ++i) {
-                            const auto &machineJobs = schedule.machineAssignments[i];
-                            std::string equipmentId = i < equipments.size() ? equipments[i] : "Unknown";
-
-                            for (const auto &job: machineJobs) {
-                                // 确保处理时间大于0（有效配置）
-                                if (job.processingTime > 0) {
-                                    results.push_back(std::make_tuple(
-                                      equipmentId,
-                                      job.lotId,
-                                      releaseTime,
-                                      job.startTime,
-                                      job.endTime));
-                                }
-                            }
-                        }
-
-                        if (!results.empty()) {
-                            if (dataManager->saveDispatchResults(results)) {
-                                std::cout << "成功保存 " << results.size() << " 条调度记录" << std::endl;
-                            }
-                            else {
-                                std::cerr << "保存调度结果时出错" << std::endl;
-                            }
-                        }
-                        else {
-                            std::cout << "没有找到有效的调度方案" << std::endl;
-                        }
-                    }
-                    else {
-                        std::cout << "没有找到有效的调度方案" << std::endl;
-                    }
+                PrefetchedSnapshot loaded = nextSnapshot.get();
+                loadSeconds               = loaded.loadSeconds;
+
+                // 调度周期不长于单轮耗时（连续调度）时，求解期间就开始加载下一轮的主数据
+                if (config.pipeline.enabled && scheduleIntervalSeconds <= cycleSeconds) {
+                    startLoad();
                 }
+
+                hasSchedule = runFullCycle(
+                  config, std::move(loaded.snapshot), writer, planPublisher.get(), coordinator, problem, currentSchedule);
             }
             catch (const std::exception &e) {
                 std::cerr << "调度计算过程中发生错误: " << e.what() << std::endl;
                 std::cerr << "将在下一轮重试" << std::endl;
             }
 
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - cycleStart;
+            cycleSeconds                          = elapsed.count();
+
+            exportProbes(config);
             std::cout << "======== 本轮调度计算结束 ========" << std::endl;
 
-            // 等待下一次调度周期，同时定期检查是否收到退出信号
-            for (int i = 0; i < scheduleIntervalSeconds && g_running; ++i) {
-                std::this_thread::sleep_for(std::chrono::seconds(1));
+            // 等待下一次调度周期，期间响应调度事件，同时定期检查是否收到退出信号。
+            // 流水线模式下提前一次加载耗时开始预取，下一轮开始时主数据刚好就绪
+            auto nextCycle  = std::chrono::steady_clock::now() + std::chrono::seconds(scheduleIntervalSeconds);
+            auto prefetchAt = nextCycle - std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                            std::chrono::duration<double>(loadSeconds));
+            while (g_running && std::chrono::steady_clock::now() < nextCycle) {
+                if (config.pipeline.enabled && !nextSnapshot.valid() && std::chrono::steady_clock::now() >= prefetchAt) {
+                    startLoad();
+                }
+                auto deadline = nextSnapshot.valid() || !config.pipeline.enabled ? nextCycle : std::min(nextCycle, prefetchAt);
+
+                if (!eventListener) {
+                    std::this_thread::sleep_until(std::min(deadline, std::chrono::steady_clock::now() + std::chrono::seconds(1)));
+                    continue;
+                }
+
+                std::vector<ScheduleEvent> events = eventListener->waitForEvents(deadline, g_running);
+                if (events.empty() || !hasSchedule) {
+                    continue;
+                }
+
+                std::cout << "\n======== " << getCurrentTimestamp() << " 事件触发增量调度 ========" << std::endl;
+                try {
+                    runIncrementalCycle(
+                      events, config, *dataManager, writer, planPublisher.get(), problem, currentSchedule);
+                }
+                catch (const std::exception &e) {
+                    std::cerr << "增量调度过程中发生错误: " << e.what() << std::endl;
+                }
+                exportProbes(config);
             }
         }
 
+        if (eventListener) {
+            eventListener->stop();
+        }
+
+        // 等待进行中的预取结束，并写完已提交的方案
+        if (nextSnapshot.valid()) {
+            nextSnapshot.wait();
+        }
+        writer.stop();
+
+        if (coordinator) {
+            coordinator->stop();
+        }
+
         std::cout << "RTD+ 调度引擎正常退出" << std::endl;
         return 0;
     }
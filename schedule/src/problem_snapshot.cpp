@@ -0,0 +1,225 @@
+#include "problem_snapshot.h"
+#include "mapped_layout.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rtd {
+namespace schedule {
+
+using namespace layout;
+
+namespace {
+
+constexpr uint32_t kSnapshotMagic   = 0x53445452;    // "RTDS"
+constexpr uint32_t kSnapshotVersion = 1;
+
+struct SnapshotHeader {
+        uint32_t magic;
+        uint32_t version;
+        int64_t  dataVersion;
+        uint64_t equipmentCount;
+        uint64_t lotCount;
+        uint64_t pairCount;
+        uint64_t equipmentIdOffset;
+        uint64_t lotIdOffset;
+        uint64_t rowOffset;
+        uint64_t columnOffset;
+        uint64_t timeOffset;
+        uint64_t fileSize;
+};
+
+/**
+ * 检查各段按写入顺序排列、起点对齐，且每段都不越过下一段的起点，
+ * 通过后按头部中的数量访问各段不会越界
+ */
+bool validSections(const SnapshotHeader &header)
+{
+    const uint64_t offsets[] = {header.equipmentIdOffset, header.lotIdOffset, header.rowOffset, header.columnOffset, header.timeOffset};
+    uint64_t       previous  = sizeof(SnapshotHeader);
+    for (uint64_t offset: offsets) {
+        if (offset < previous || !isAligned8(offset)) {
+            return false;
+        }
+        previous = offset;
+    }
+
+    // 行索引比批次数多一项，批次数加一不能溢出
+    if (header.lotCount == UINT64_MAX) {
+        return false;
+    }
+
+    return sectionFits(header.rowOffset, header.lotCount + 1, sizeof(uint64_t), header.columnOffset) && sectionFits(header.columnOffset, header.pairCount, sizeof(uint32_t), header.timeOffset) && sectionFits(header.timeOffset, header.pairCount, sizeof(double), header.fileSize);
+}
+
+}    // namespace
+
+bool writeProblemSnapshot(const std::string &path, const MasterDataSnapshot &snapshot)
+{
+    const size_t equipmentCount = snapshot.equipments.size();
+    const size_t lotCount       = snapshot.lots.size();
+    if (snapshot.processingTimes.size() != lotCount) {
+        return false;
+    }
+
+    size_t pairCount = 0;
+    for (const auto &row: snapshot.processingTimes) {
+        if (row.size() != equipmentCount) {
+            return false;
+        }
+        for (double time: row) {
+            pairCount += time > 0 ? 1 : 0;
+        }
+    }
+
+    SnapshotHeader header {};
+    header.magic             = kSnapshotMagic;
+    header.version           = kSnapshotVersion;
+    header.dataVersion       = snapshot.version;
+    header.equipmentCount    = equipmentCount;
+    header.lotCount          = lotCount;
+    header.pairCount         = pairCount;
+    header.equipmentIdOffset = align8(sizeof(SnapshotHeader));
+    header.lotIdOffset       = align8(header.equipmentIdOffset + idSectionSize(snapshot.equipments));
+    header.rowOffset         = align8(header.lotIdOffset + idSectionSize(snapshot.lots));
+    header.columnOffset      = header.rowOffset + (lotCount + 1) * sizeof(uint64_t);
+    header.timeOffset        = align8(header.columnOffset + pairCount * sizeof(uint32_t));
+    header.fileSize          = header.timeOffset + pairCount * sizeof(double);
+
+    // 写入临时文件
+    std::string tmpPath = path + ".tmp";
+    int         fd      = ::open(tmpPath.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "Failed to create snapshot file " << tmpPath << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(header.fileSize)) != 0) {
+        std::cerr << "Failed to resize snapshot file: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+
+    void *mapped = ::mmap(nullptr, header.fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        std::cerr << "Failed to map snapshot file: " << std::strerror(errno) << std::endl;
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+
+    char *base = static_cast<char *>(mapped);
+    std::memcpy(base, &header, sizeof(header));
+    writeIds(base + header.equipmentIdOffset, snapshot.equipments);
+    writeIds(base + header.lotIdOffset, snapshot.lots);
+
+    auto *rows    = reinterpret_cast<uint64_t *>(base + header.rowOffset);
+    auto *columns = reinterpret_cast<uint32_t *>(base + header.columnOffset);
+    auto *times   = reinterpret_cast<double *>(base + header.timeOffset);
+
+    size_t pair = 0;
+    for (size_t i = 0; i < lotCount; ++i) {
+        rows[i] = pair;
+        for (size_t j = 0; j < equipmentCount; ++j) {
+            double time = snapshot.processingTimes[i][j];
+            if (time > 0) {
+                columns[pair] = static_cast<uint32_t>(j);
+                times[pair]   = time;
+                ++pair;
+            }
+        }
+    }
+    rows[lotCount] = pair;
+
+    ::munmap(mapped, header.fileSize);
+
+    // 原子替换，回放时不会读到半写的快照
+    if (::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Failed to write snapshot " << path << ": " << std::strerror(errno) << std::endl;
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool readProblemSnapshot(const std::string &path, MasterDataSnapshot &snapshot)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+    void        *mapped   = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    const char *base = static_cast<const char *>(mapped);
+    bool        ok   = false;
+
+    SnapshotHeader header;
+    std::memcpy(&header, base, sizeof(header));
+
+    MasterDataSnapshot loaded;
+    if (header.magic == kSnapshotMagic && header.version == kSnapshotVersion && header.fileSize == fileSize && validSections(header) && readIds(base, header.equipmentIdOffset, header.equipmentCount, header.lotIdOffset, loaded.equipments) && readIds(base, header.lotIdOffset, header.lotCount, header.rowOffset, loaded.lots)) {
+        const auto *rows    = reinterpret_cast<const uint64_t *>(base + header.rowOffset);
+        const auto *columns = reinterpret_cast<const uint32_t *>(base + header.columnOffset);
+        const auto *times   = reinterpret_cast<const double *>(base + header.timeOffset);
+
+        loaded.version = header.dataVersion;
+        loaded.processingTimes.assign(header.lotCount, std::vector<double>(header.equipmentCount, 0.0));
+
+        ok = rows[header.lotCount] == header.pairCount;
+        for (size_t i = 0; i < header.lotCount && ok; ++i) {
+            if (rows[i] > rows[i + 1] || rows[i + 1] > header.pairCount) {
+                ok = false;
+                break;
+            }
+            for (uint64_t pair = rows[i]; pair < rows[i + 1]; ++pair) {
+                if (columns[pair] >= header.equipmentCount) {
+                    ok = false;
+                    break;
+                }
+                loaded.processingTimes[i][columns[pair]] = times[pair];
+            }
+        }
+    }
+
+    ::munmap(mapped, fileSize);
+
+    if (ok) {
+        snapshot = std::move(loaded);
+    }
+    return ok;
+}
+
+bool isProblemSnapshotFile(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    uint32_t magic = 0;
+    bool     ok    = ::read(fd, &magic, sizeof(magic)) == static_cast<ssize_t>(sizeof(magic)) && magic == kSnapshotMagic;
+    ::close(fd);
+    return ok;
+}
+
+}    // namespace schedule
+}    // namespace rtd
@@ -1,35 +1,54 @@
 #include "schedule_chromosome.h"
+#include "schedule_probe.h"
 #include <numeric>
 #include <unordered_set>
 
 namespace rtd {
 namespace schedule {
 
-// 创建随机染色体时确保所有批次分配到有效机台
-Chromosome Chromosome::createRandom(
+EligibilityTable::EligibilityTable(
   size_t                                  lotCount,
   size_t                                  machineCount,
-  const std::vector<std::vector<double>> &processingTimes,
-  std::mt19937                           &generator)
+  const std::vector<std::vector<double>> &processingTimes)
+    : m_machineCount(machineCount), m_machines(lotCount), m_eligible(lotCount * machineCount, false)
 {
-    // 创建一个有效的分配序列
-    std::vector<size_t> validGenes;
-
-    // 对于每个批次，找到所有有效的机台分配
     for (size_t i = 0; i < lotCount; ++i) {
-        std::vector<size_t> validMachines;
         for (size_t j = 0; j < machineCount; ++j) {
             // 仅当处理时间大于零时才是有效分配
             if (processingTimes[i][j] > 0) {
-                // 有效分配的编码：i * machineCount + j
-                validMachines.push_back(i * machineCount + j);
+                m_machines[i].push_back(j);
+                m_eligible[i * machineCount + j] = true;
             }
         }
+    }
+}
 
-        // 如果有有效机台，随机选一个加入序列
-        if (!validMachines.empty()) {
-            std::uniform_int_distribution<size_t> dist(0, validMachines.size() - 1);
-            validGenes.push_back(validMachines[dist(generator)]);
+// 创建随机染色体时确保所有批次分配到有效机台
+Chromosome Chromosome::createRandom(
+  size_t                                  lotCount,
+  size_t                                  machineCount,
+  const std::vector<std::vector<double>> &processingTimes,
+  std::mt19937                           &generator)
+{
+    return createRandom(EligibilityTable(lotCount, machineCount, processingTimes), generator);
+}
+
+Chromosome Chromosome::createRandom(const EligibilityTable &eligibility, std::mt19937 &generator)
+{
+    RTD_PROBE_SCOPE("chromosome.create_random");
+
+    const size_t machineCount = eligibility.machineCount();
+
+    // 创建一个有效的分配序列
+    std::vector<size_t> validGenes;
+    validGenes.reserve(eligibility.lotCount());
+
+    // 每个批次从可加工机台中随机选一个，编码为 i * machineCount + j
+    for (size_t i = 0; i < eligibility.lotCount(); ++i) {
+        const auto &machines = eligibility.machines(i);
+        if (!machines.empty()) {
+            std::uniform_int_distribution<size_t> dist(0, machines.size() - 1);
+            validGenes.push_back(i * machineCount + machines[dist(generator)]);
         }
     }
 
@@ -41,6 +60,8 @@ Chromosome Chromosome::createRandom(
 
 Chromosome Chromosome::crossover(const Chromosome &other, std::mt19937 &generator) const
 {
+    RTD_PROBE_SCOPE("chromosome.crossover");
+
     if (m_genes.size() != other.m_genes.size()) {
         throw std::invalid_argument("Chromosomes must have the same length");
     }
@@ -86,6 +107,8 @@ Chromosome Chromosome::crossover(const Chromosome &other, std::mt19937 &generato
 
 void Chromosome::mutate(double mutationRate, std::mt19937 &generator)
 {
+    RTD_PROBE_SCOPE("chromosome.mutate");
+
     if (m_genes.size() <= 1) {
         return;    // 太短无法变异
     }
@@ -103,6 +126,88 @@ void Chromosome::mutate(double mutationRate, std::mt19937 &generator)
     }
 }
 
+Chromosome Chromosome::crossoverByLot(
+  const Chromosome       &other,
+  const EligibilityTable &eligibility,
+  std::mt19937           &generator) const
+{
+    RTD_PROBE_SCOPE("chromosome.crossover");
+
+    const size_t length       = m_genes.size();
+    const size_t machineCount = eligibility.machineCount();
+    if (length <= 2 || other.m_genes.size() != length) {
+        return *this;
+    }
+
+    std::uniform_int_distribution<size_t> dist(0, length - 1);
+    size_t                                start = dist(generator);
+    size_t                                end   = dist(generator);
+    if (start > end) {
+        std::swap(start, end);
+    }
+
+    std::vector<size_t> childGenes(length, 0);
+    std::vector<bool>   lotUsed(eligibility.lotCount(), false);
+
+    // 将父代的中间部分复制到子代
+    for (size_t i = start; i <= end; ++i) {
+        childGenes[i]                      = m_genes[i];
+        lotUsed[m_genes[i] / machineCount] = true;
+    }
+
+    // 从另一个父代中按顺序取未出现的批次填充
+    size_t j      = (end + 1) % length;
+    size_t filled = end - start + 1;
+    for (size_t i = 0; i < length && filled < length; ++i) {
+        size_t gene = other.m_genes[(end + 1 + i) % length];
+        size_t lot  = gene / machineCount;
+        if (!lotUsed[lot]) {
+            childGenes[j] = gene;
+            lotUsed[lot]  = true;
+            j             = (j + 1) % length;
+            ++filled;
+        }
+    }
+
+    // 两个父代的批次集合不同（未经修复的个体）时放弃交叉
+    if (filled < length) {
+        return *this;
+    }
+
+    return Chromosome(childGenes);
+}
+
+void Chromosome::mutateAssignment(
+  double                  mutationRate,
+  const EligibilityTable &eligibility,
+  std::mt19937           &generator)
+{
+    RTD_PROBE_SCOPE("chromosome.mutate_assignment");
+
+    const size_t                           machineCount = eligibility.machineCount();
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    for (size_t &gene: m_genes) {
+        if (dist(generator) >= mutationRate) {
+            continue;
+        }
+
+        size_t      lot      = gene / machineCount;
+        const auto &machines = eligibility.machines(lot);
+        if (machines.size() <= 1) {
+            continue;    // 只有一台可加工机台
+        }
+
+        // 在除当前机台外的可加工机台中均匀选取
+        std::uniform_int_distribution<size_t> machineDist(0, machines.size() - 2);
+        size_t                                machine = machines[machineDist(generator)];
+        if (machine == gene % machineCount) {
+            machine = machines.back();
+        }
+        gene = lot * machineCount + machine;
+    }
+}
+
 // 修改染色体验证方法，确保只考虑有效的处理时间
 bool Chromosome::isValid(
   size_t                                  lotCount,
@@ -152,103 +257,80 @@ void Chromosome::repair(
   const std::vector<std::vector<double>> &processingTimes,
   std::mt19937                           &generator)
 {
+    repair(EligibilityTable(lotCount, machineCount, processingTimes), generator);
+}
+
+void Chromosome::repair(const EligibilityTable &eligibility, std::mt19937 &generator)
+{
+    RTD_PROBE_SCOPE("chromosome.repair");
+
+    const size_t lotCount     = eligibility.lotCount();
+    const size_t machineCount = eligibility.machineCount();
+
     // 检查每个批次是否分配到有效机台
     std::vector<bool>   lotAssigned(lotCount, false);
     std::vector<size_t> invalidPositions;
 
     for (size_t i = 0; i < m_genes.size(); ++i) {
-        size_t gene    = m_genes[i];
-        size_t lot     = gene / machineCount;
-        size_t machine = gene % machineCount;
-
-        // 检查基因是否有效
-        bool valid = true;
+        size_t lot     = m_genes[i] / machineCount;
+        size_t machine = m_genes[i] % machineCount;
 
-        // 批次索引越界
-        if (lot >= lotCount) {
-            valid = false;
-        }
-        // 机台索引越界
-        else if (machine >= machineCount) {
-            valid = false;
-        }
-        // 处理时间无效
-        else if (processingTimes[lot][machine] <= 0) {
-            valid = false;
-        }
-        // 批次重复
-        else if (lotAssigned[lot]) {
-            valid = false;
-        }
-
-        if (valid) {
-            lotAssigned[lot] = true;
+        // 批次越界、处理时间无效或批次重复
+        if (lot >= lotCount || !eligibility.isEligible(lot, machine) || lotAssigned[lot]) {
+            invalidPositions.push_back(i);
         }
         else {
-            invalidPositions.push_back(i);
+            lotAssigned[lot] = true;
         }
     }
 
     // 找出未分配的批次
     std::vector<size_t> unassignedLots;
     for (size_t i = 0; i < lotCount; ++i) {
-        if (!lotAssigned[i]) {
+        if (!lotAssigned[i] && !eligibility.machines(i).empty()) {
             unassignedLots.push_back(i);
         }
     }
 
-    // 处理无效位置和未分配批次
-    for (size_t i = 0; i < invalidPositions.size() || !unassignedLots.empty();) {
-        if (i < invalidPositions.size()) {
-            size_t pos = invalidPositions[i];
-
-            if (!unassignedLots.empty()) {
-                // 修复为未分配批次的有效机台
-                size_t lot = unassignedLots.back();
-                unassignedLots.pop_back();
-
-                // 找到该批次的有效机台
-                std::vector<size_t> validMachines;
-                for (size_t j = 0; j < machineCount; ++j) {
-                    if (processingTimes[lot][j] > 0) {    // 确保处理时间大于0
-                        validMachines.push_back(j);
-                    }
-                }
-
-                if (!validMachines.empty()) {
-                    std::uniform_int_distribution<size_t> dist(0, validMachines.size() - 1);
-                    size_t                                machine = validMachines[dist(generator)];
-                    m_genes[pos]                                  = lot * machineCount + machine;
-                }
-
-                ++i;
-            }
-            else {
-                // 删除多余的基因
-                m_genes.erase(m_genes.begin() + pos);
-                invalidPositions.erase(invalidPositions.begin() + i);
-                // 不增加i，因为数组已经移除一个元素
-            }
-        }
-        else if (!unassignedLots.empty()) {
-            // 添加新基因
-            size_t lot = unassignedLots.back();
-            unassignedLots.pop_back();
-
-            // 找到该批次的有效机台
-            std::vector<size_t> validMachines;
-            for (size_t j = 0; j < machineCount; ++j) {
-                if (processingTimes[lot][j] > 0) {    // 确保处理时间大于0
-                    validMachines.push_back(j);
-                }
-            }
+    RTD_PROBE_COUNT("chromosome.repair_invalid_genes", invalidPositions.size());
+    RTD_PROBE_COUNT("chromosome.repair_missing_lots", unassignedLots.size());
 
-            if (!validMachines.empty()) {
-                std::uniform_int_distribution<size_t> dist(0, validMachines.size() - 1);
-                size_t                                machine = validMachines[dist(generator)];
-                m_genes.push_back(lot * machineCount + machine);
+    if (invalidPositions.empty() && unassignedLots.empty()) {
+        return;
+    }
+
+    // 随机选取批次的可加工机台
+    auto randomGene = [&](size_t lot) {
+        const auto                           &machines = eligibility.machines(lot);
+        std::uniform_int_distribution<size_t> dist(0, machines.size() - 1);
+        return lot * machineCount + machines[dist(generator)];
+    };
+
+    // 无效位置依次改填未分配批次
+    size_t filled = 0;
+    while (filled < invalidPositions.size() && !unassignedLots.empty()) {
+        m_genes[invalidPositions[filled++]] = randomGene(unassignedLots.back());
+        unassignedLots.pop_back();
+    }
+
+    // 一次性压缩删除剩余的无效位置
+    if (filled < invalidPositions.size()) {
+        size_t write = invalidPositions[filled];
+        size_t next  = filled;
+        for (size_t read = write; read < m_genes.size(); ++read) {
+            if (next < invalidPositions.size() && invalidPositions[next] == read) {
+                ++next;
+                continue;
             }
+            m_genes[write++] = m_genes[read];
         }
+        m_genes.resize(write);
+    }
+
+    // 仍未分配的批次追加到末尾
+    while (!unassignedLots.empty()) {
+        m_genes.push_back(randomGene(unassignedLots.back()));
+        unassignedLots.pop_back();
     }
 }
 
@@ -0,0 +1,102 @@
+#include "schedule_config.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace rtd {
+namespace schedule {
+
+ScheduleConfig ScheduleConfig::load(const std::string &filePath)
+{
+    ScheduleConfig config;
+
+    std::ifstream configFile(filePath);
+    if (!configFile.is_open()) {
+        std::cout << "未找到调度配置文件 " << filePath << "，使用默认配置" << std::endl;
+        return config;
+    }
+
+    try {
+        json root;
+        configFile >> root;
+
+        if (root.contains("dispatch_plan")) {
+            const auto &plan            = root["dispatch_plan"];
+            config.dispatchPlan.enabled = plan.value("enabled", config.dispatchPlan.enabled);
+            config.dispatchPlan.path    = plan.value("path", config.dispatchPlan.path);
+        }
+
+        if (root.contains("events")) {
+            const auto &events              = root["events"];
+            config.events.enabled           = events.value("enabled", config.events.enabled);
+            config.events.socketPath        = events.value("socket_path", config.events.socketPath);
+            config.events.debounceMs        = events.value("debounce_ms", config.events.debounceMs);
+            config.events.refineGenerations = events.value("refine_generations", config.events.refineGenerations);
+        }
+
+        if (root.contains("distributed")) {
+            const auto &distributed           = root["distributed"];
+            config.distributed.enabled        = distributed.value("enabled", config.distributed.enabled);
+            config.distributed.listenPort     = distributed.value("listen_port", config.distributed.listenPort);
+            config.distributed.timeoutSeconds = distributed.value("timeout_seconds", config.distributed.timeoutSeconds);
+        }
+
+        if (root.contains("checkpoint")) {
+            const auto &checkpoint                = root["checkpoint"];
+            config.checkpoint.enabled             = checkpoint.value("enabled", config.checkpoint.enabled);
+            config.checkpoint.path                = checkpoint.value("path", config.checkpoint.path);
+            config.checkpoint.intervalGenerations = checkpoint.value("interval_generations", config.checkpoint.intervalGenerations);
+        }
+
+        if (root.contains("telemetry")) {
+            const auto &telemetry    = root["telemetry"];
+            config.telemetry.enabled = telemetry.value("enabled", config.telemetry.enabled);
+            config.telemetry.path    = telemetry.value("path", config.telemetry.path);
+        }
+
+        if (root.contains("snapshot")) {
+            const auto &snapshot             = root["snapshot"];
+            config.snapshot.fullReloadCycles = snapshot.value("full_reload_cycles", config.snapshot.fullReloadCycles);
+            config.snapshot.recordPath       = snapshot.value("record_path", config.snapshot.recordPath);
+            config.snapshot.replayPath       = snapshot.value("replay_path", config.snapshot.replayPath);
+        }
+
+        if (root.contains("dispatch_write")) {
+            const auto &dispatchWrite      = root["dispatch_write"];
+            config.dispatchWrite.batchSize = dispatchWrite.value("batch_size", config.dispatchWrite.batchSize);
+            config.dispatchWrite.diff      = dispatchWrite.value("diff", config.dispatchWrite.diff);
+        }
+
+        if (root.contains("pipeline")) {
+            const auto &pipeline       = root["pipeline"];
+            config.pipeline.enabled    = pipeline.value("enabled", config.pipeline.enabled);
+            config.pipeline.writeQueue = std::max<size_t>(pipeline.value("write_queue", config.pipeline.writeQueue), 1);
+        }
+
+        if (root.contains("ga")) {
+            std::string encoding = root["ga"].value("encoding", chromosomeEncodingName(config.ga.encoding));
+            if (!parseChromosomeEncoding(encoding, config.ga.encoding)) {
+                std::cerr << "未知的染色体编码 " << encoding << "，使用 " << chromosomeEncodingName(config.ga.encoding) << std::endl;
+            }
+            config.ga.threads        = root["ga"].value("threads", config.ga.threads);
+            config.ga.offspringChunk = root["ga"].value("offspring_chunk", config.ga.offspringChunk);
+            config.ga.pinThreads     = root["ga"].value("pin_threads", config.ga.pinThreads);
+        }
+
+        if (root.contains("profile")) {
+            config.profile.tracePath = root["profile"].value("trace_path", config.profile.tracePath);
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << "解析调度配置文件失败: " << e.what() << "，使用默认配置" << std::endl;
+        return ScheduleConfig();
+    }
+
+    return config;
+}
+
+}    // namespace schedule
+}    // namespace rtd
@@ -1,13 +1,19 @@
 #include "schedule_data_manager.h"
+#include "data_source_backend.h"
+#include "session_pool.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <mutex>
 #include <nlohmann/json.hpp>
-#include <set>    // 添加set头文件
-#include <soci/odbc/soci-odbc.h>
+#include <set>
 #include <soci/soci.h>
 #include <thread>
+#include <tuple>
 #include <unordered_map>
 
 using json = nlohmann::json;
@@ -25,10 +31,18 @@ class ScheduleDataManagerImpl: public ScheduleDataManager {
         std::vector<std::string>         getAllEquipments() override;
         std::vector<std::string>         getLotsByEquipment(const std::string &equipmentId) override;
         std::vector<std::string>         getAllLots() override;
+        LotEligibility                   getLotEligibility(const std::vector<std::string> &equipments) override;
         double                           getProcessTime(const std::string &equipmentId, const std::string &lotId) override;
+        std::map<std::string, double>    getProcessTimesByLot(
+          const std::string              &lotId,
+          const std::vector<std::string> &equipments) override;
         std::vector<std::vector<double>> getProcessTimeMatrix(
           const std::vector<std::string> &lots,
           const std::vector<std::string> &equipments) override;
+        std::vector<std::vector<double>> getProcessTimeMatrix(
+          const LotEligibility           &eligibility,
+          const std::vector<std::string> &equipments) override;
+        const MasterDataSnapshot        &refreshSnapshot(bool fullReload) override;
         bool saveDispatchResult(
           const std::string &equipmentId,
           const std::string &lotId,
@@ -37,10 +51,15 @@ class ScheduleDataManagerImpl: public ScheduleDataManager {
           double             endTime) override;
         bool saveDispatchResults(
           const std::vector<std::tuple<std::string, std::string, double, double, double>> &results) override;
+        bool saveDispatchDiff(
+          const std::vector<std::tuple<std::string, std::string, double, double, double>> &results,
+          double                                                                           releaseTime) override;
+        void setDispatchBatchSize(size_t batchSize) override;
 
     private:
         // 数据源配置
         struct DataSourceConfig {
+                std::string backend;
                 std::string dsnPath;
                 int         minConn;
                 int         maxConn;
@@ -57,11 +76,33 @@ class ScheduleDataManagerImpl: public ScheduleDataManager {
                 std::vector<std::string> params;
         };
 
-        std::map<std::string, DataSourceConfig>         m_configs;
-        std::map<std::string, std::shared_ptr<session>> m_sessions;
-        std::map<std::string, QueryInfo>                m_queries;
-        std::mutex                                      m_mutex;
-        bool                                            m_initialized = false;
+        std::map<std::string, DataSourceConfig>             m_configs;
+        std::map<std::string, std::shared_ptr<SessionPool>> m_pools;
+        std::map<std::string, QueryInfo>                    m_queries;
+        std::mutex                                          m_mutex;
+        bool                                                m_initialized       = false;
+        size_t                                              m_dispatchBatchSize = kDefaultDispatchBatchSize;
+
+        // 主数据快照，以及增量更新用的稀疏副本（按ID索引，不依赖矩阵下标）
+        MasterDataSnapshot                                                       m_snapshot;
+        bool                                                                     m_hasSnapshot = false;
+        std::map<std::string, std::set<std::string>>                             m_relation;    // 批次 → 可加工设备
+        std::unordered_map<std::string, std::unordered_map<std::string, double>> m_times;       // 批次 → 设备 → 处理时间，全量加载时清理
+
+        // 主数据查询的失败次数：返回空结果而不抛出异常的查询接口出错时各计一次，加载快照前后比较以发现不完整的结果
+        std::atomic<size_t> m_queryFailures {0};
+
+        // 已发布的派工记录，与dispatch表一致，按批次索引
+        struct PublishedDispatch {
+                std::string equipmentId;
+                double      startTime = 0.0;
+                double      endTime   = 0.0;
+        };
+
+        std::unordered_map<std::string, PublishedDispatch> m_published;
+        std::set<std::string>                              m_duplicateLots;    // dispatch表中有多行的批次，下次写入时删除后重新插入
+        bool                                               m_hasPublished   = false;
+        long long                                          m_releaseVersion = 0;    // 最近一次发布头的版本号
 
         // 加载配置文件
         bool loadDataSourceConfig(const std::string &filePath);
@@ -70,14 +111,146 @@ class ScheduleDataManagerImpl: public ScheduleDataManager {
         // 加载DSN文件
         std::string loadDsn(const std::string &dsnPath);
 
-        // 获取数据库会话
-        std::shared_ptr<session> getSession(const std::string &dataSourceName);
+        // 从连接池租用数据库会话，返回的指针析构时归还
+        std::shared_ptr<PooledSession> getSession(const std::string &dataSourceName);
+
+        // 数据源可同时执行的查询数（连接池上限）
+        size_t concurrencyOf(const std::string &dataSourceName);
+
+        // 一次取回所有(批次ID, 设备ID)关系，未配置getLotEqpRelation时返回false
+        bool fetchLotEqpRelation(std::vector<std::pair<std::string, std::string>> &rows);
+
+        // 查询一个配对的处理时间，没有记录时返回0，查询失败时抛出异常
+        double queryProcessTime(const std::string &equipmentId, const std::string &lotId);
+
+        // 用getProcessTimeByLot一次取回一个批次的(设备ID, 处理时间)，未配置时返回false，查询失败时抛出异常
+        bool fetchProcessTimesByLot(const std::string &lotId, std::vector<std::pair<std::string, double>> &rows);
+
+        // 由关系行生成批次与可加工设备的关系，只保留equipments中的设备
+        LotEligibility buildLotEligibility(
+          const std::vector<std::pair<std::string, std::string>> &rows,
+          const std::vector<std::string>                         &equipments);
+
+        // 加载处理时间矩阵，eligibility非空时逐对查询只查询可加工配对
+        std::vector<std::vector<double>> buildProcessTimeMatrix(
+          const std::vector<std::string> &lots,
+          const std::vector<std::string> &equipments,
+          const LotEligibility           *eligibility);
+
+        // 全量加载快照，任一查询失败时保留原快照并返回false，下一轮重新全量加载
+        bool loadFullSnapshot();
+
+        // 查询版本号大于快照版本的变更，全部查询成功后才应用到设备列表和稀疏副本，返回是否有变更
+        bool applySnapshotDelta();
+
+        // 由设备列表和稀疏副本重建批次列表和处理时间矩阵
+        void rebuildSnapshot();
+
+        // 查询当前数据版本号
+        long long queryDataVersion();
+
+        // 增量查询是否都已配置
+        bool hasSnapshotDeltaQueries() const;
+
+        // 差量写入所需的查询是否都已配置
+        bool hasDispatchDiffQueries() const;
+
+        // 从数据库读取当前已发布的派工记录和最大发布版本号
+        void loadPublishedDispatch(PooledSession &sql);
+
+        // 用一次集合查询流式填充处理时间矩阵，返回读取的行数
+        // shard非空时只查询第shard->second个分片（共shard->first个）的行，
+        // 分片由数据库按设备ID散列划分，各分片的设备互不重叠，只写这些设备对应的列
+        size_t loadProcessTimeMatrix(
+          const QueryInfo                               &query,
+          const std::unordered_map<std::string, size_t> &lotIndexMap,
+          const std::unordered_map<std::string, size_t> &equipmentIndexMap,
+          std::vector<std::vector<double>>              &matrix,
+          const std::pair<int, int>                     *shard = nullptr);
 };
 
+namespace {
+
+/**
+ * 把[0, count)分成至多shards段，每段调用一次fn(begin, end)
+ * 第一段在调用线程上执行，其余各用一个线程；全部完成后返回，并重新抛出其他线程中的异常
+ */
+template<typename Fn>
+void runSharded(size_t count, size_t shards, const Fn &fn)
+{
+    shards = std::min(shards, count);
+    if (shards <= 1) {
+        if (count > 0) {
+            fn(0, count);
+        }
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    for (size_t s = 1; s < shards; ++s) {
+        size_t begin = count * s / shards;
+        size_t end   = count * (s + 1) / shards;
+        futures.push_back(std::async(std::launch::async, [&fn, begin, end]() { fn(begin, end); }));
+    }
+
+    fn(0, count / shards);
+    for (auto &future: futures) {
+        future.get();
+    }
+}
+
+/**
+ * 用数组绑定分批执行rows行的语句，返回执行次数
+ * 每批先调用fill(first, count)填充各参数数组的前count个元素；整批共用一次绑定，
+ * 最后不足一批的部分数组长度变化后重新绑定
+ */
+template<typename Fill, typename... Columns>
+size_t executeInBatches(PooledSession &sql, const std::string &id, const std::string &text, size_t rows, size_t batchSize, const Fill &fill, std::vector<Columns> &...columns)
+{
+    if (rows == 0) {
+        return 0;
+    }
+
+    batchSize = std::min(std::max<size_t>(batchSize, 1), rows);
+
+    const size_t fullBatches = rows / batchSize;
+    (columns.resize(batchSize), ...);
+    if (fullBatches > 0) {
+        statement &stmt = sql.bind(id, text, use(columns)...);
+        for (size_t b = 0; b < fullBatches; ++b) {
+            fill(b * batchSize, batchSize);
+            stmt.execute(true);
+        }
+    }
+
+    const size_t remaining = rows - fullBatches * batchSize;
+    if (remaining == 0) {
+        return fullBatches;
+    }
+
+    (columns.resize(remaining), ...);
+    fill(fullBatches * batchSize, remaining);
+
+    sql.bind(id, text, use(columns)...).execute(true);
+    return fullBatches + 1;
+}
+
+}    // namespace
+
+// 集合查询每次从游标取回的行数
+constexpr size_t kProcessTimeFetchRows = 10000;
+constexpr size_t kRelationFetchRows    = 10000;
+constexpr size_t kDeltaFetchRows       = 1000;
+constexpr size_t kDispatchFetchRows    = 10000;
+constexpr size_t kListFetchRows        = 1000;
+
+// 开始、结束时间之差小于该值视为未变化
+constexpr double kDispatchTimeEpsilon = 1e-6;
+
 ScheduleDataManagerImpl::~ScheduleDataManagerImpl()
 {
-    // 清理会话
-    m_sessions.clear();
+    // 清理连接池，仍被租用的会话归还后随池一起释放
+    m_pools.clear();
 }
 
 bool ScheduleDataManagerImpl::initialize(const std::string &configPath)
@@ -98,17 +271,22 @@ bool ScheduleDataManagerImpl::initialize(const std::string &configPath)
             return false;
         }
 
-        // 初始化数据库连接
+        // 初始化数据库连接池，每个数据源先建立min_conn个会话
         for (const auto &[name, config]: m_configs) {
-            try {
-                auto sess        = std::make_shared<session>(odbc, config.connectionString);
-                m_sessions[name] = sess;
-                std::cout << "Connected to " << name << " database" << std::endl;
-            }
-            catch (const std::exception &e) {
-                std::cerr << "Failed to connect to " << name << ": " << e.what() << std::endl;
+            auto pool = std::make_shared<SessionPool>(
+              *datasource::backendFactory(config.backend),
+              config.connectionString,
+              static_cast<size_t>(std::max(config.minConn, 0)),
+              static_cast<size_t>(std::max(config.maxConn, 1)),
+              std::chrono::seconds(std::max(config.connTimeout, 1)));
+            if (!pool->open()) {
+                std::cerr << "Failed to connect to " << name << std::endl;
                 return false;
             }
+
+            m_pools[name] = pool;
+            std::cout << "Connected to " << name << " database via " << config.backend << " (pool " << config.minConn
+                      << "-" << config.maxConn << ")" << std::endl;
         }
 
         m_initialized = true;
@@ -135,11 +313,17 @@ bool ScheduleDataManagerImpl::loadDataSourceConfig(const std::string &filePath)
         // 解析每个数据源的配置
         for (auto &[name, source]: config.items()) {
             DataSourceConfig sourceConfig;
+            sourceConfig.backend     = source.value("backend", datasource::kDefaultBackend);
             sourceConfig.dsnPath     = source["dsn_path"];
             sourceConfig.minConn     = source["min_conn"];
             sourceConfig.maxConn     = source["max_conn"];
             sourceConfig.connTimeout = source["conn_timeout"];
 
+            if (!datasource::backendFactory(sourceConfig.backend)) {
+                std::cerr << "Unsupported backend for " << name << ": " << sourceConfig.backend << std::endl;
+                continue;
+            }
+
             // 加载DSN文件内容
             sourceConfig.connectionString = loadDsn(sourceConfig.dsnPath);
             if (sourceConfig.connectionString.empty()) {
@@ -170,13 +354,21 @@ bool ScheduleDataManagerImpl::loadApiConfig(const std::string &filePath)
         json config;
         configFile >> config;
 
-        // 解析查询配置
+        // 解析查询配置，"enabled"为false的查询视为未配置（用于默认关闭的可选功能）
         for (const auto &query: config["api"]) {
+            if (!query.value("enabled", true)) {
+                continue;
+            }
+
             QueryInfo info;
             info.id          = query["id"];
             info.dataSource  = query["data_source"];
             info.description = query["description"];
-            info.sql         = query["sql"];
+
+            // 按数据源的后端选择SQL方言，数据源未配置时按缺省后端
+            auto        source  = m_configs.find(info.dataSource);
+            std::string backend = source == m_configs.end() ? datasource::kDefaultBackend : source->second.backend;
+            info.sql            = datasource::querySql(query, backend);
 
             for (const auto &param: query["params"]) {
                 info.params.push_back(param);
@@ -204,29 +396,30 @@ std::string ScheduleDataManagerImpl::loadDsn(const std::string &dsnPath)
     return content;
 }
 
-std::shared_ptr<session> ScheduleDataManagerImpl::getSession(const std::string &dataSourceName)
+std::shared_ptr<PooledSession> ScheduleDataManagerImpl::getSession(const std::string &dataSourceName)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    auto it = m_sessions.find(dataSourceName);
-    if (it != m_sessions.end()) {
-        return it->second;
-    }
-
-    // 如果会话不存在，尝试创建一个新的
-    auto configIt = m_configs.find(dataSourceName);
-    if (configIt != m_configs.end()) {
-        try {
-            auto sess                  = std::make_shared<session>(odbc, configIt->second.connectionString);
-            m_sessions[dataSourceName] = sess;
-            return sess;
-        }
-        catch (const std::exception &e) {
-            std::cerr << "Failed to create database session: " << e.what() << std::endl;
+    std::shared_ptr<SessionPool> pool;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_pools.find(dataSourceName);
+        if (it == m_pools.end()) {
+            std::cerr << "Unknown data source: " << dataSourceName << std::endl;
+            return nullptr;
         }
+        pool = it->second;
     }
 
-    return nullptr;
+    // 池满时在锁外等待其他查询归还会话
+    return pool->acquire();
+}
+
+size_t ScheduleDataManagerImpl::concurrencyOf(const std::string &dataSourceName)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_pools.find(dataSourceName);
+    return it == m_pools.end() ? 1 : it->second->capacity();
 }
 
 std::vector<std::string> ScheduleDataManagerImpl::getAllEquipments()
@@ -245,14 +438,18 @@ std::vector<std::string> ScheduleDataManagerImpl::getAllEquipments()
             throw std::runtime_error("Failed to get database session");
         }
 
-        rowset<row> rs = (session->prepare << query.sql);
+        std::vector<std::string> eqpIds(kListFetchRows);
 
-        for (const auto &r: rs) {
-            equipments.push_back(r.get<std::string>("EQP_ID"));
+        statement &stmt = session->bind(query.id, query.sql, into(eqpIds));
+        stmt.execute();
+        while (stmt.fetch()) {
+            equipments.insert(equipments.end(), eqpIds.begin(), eqpIds.end());
+            eqpIds.resize(kListFetchRows);
         }
     }
     catch (const std::exception &e) {
         std::cerr << "Failed to get equipments: " << e.what() << std::endl;
+        ++m_queryFailures;
     }
 
     return equipments;
@@ -274,15 +471,18 @@ std::vector<std::string> ScheduleDataManagerImpl::getLotsByEquipment(const std::
             throw std::runtime_error("Failed to get database session");
         }
 
-        // 修复: 使用正确方式创建有参数的rowset
-        rowset<row> rs = (session->prepare << query.sql, use(equipmentId));
+        std::vector<std::string> lotIds(kListFetchRows);
 
-        for (const auto &r: rs) {
-            lots.push_back(r.get<std::string>("LOT_ID"));
+        statement &stmt = session->bind(query.id, query.sql, use(equipmentId), into(lotIds));
+        stmt.execute();
+        while (stmt.fetch()) {
+            lots.insert(lots.end(), lotIds.begin(), lotIds.end());
+            lotIds.resize(kListFetchRows);
         }
     }
     catch (const std::exception &e) {
         std::cerr << "Failed to get lots by equipment: " << e.what() << std::endl;
+        ++m_queryFailures;
     }
 
     return lots;
@@ -290,65 +490,229 @@ std::vector<std::string> ScheduleDataManagerImpl::getLotsByEquipment(const std::
 
 std::vector<std::string> ScheduleDataManagerImpl::getAllLots()
 {
-    std::vector<std::string> lots;
-    std::set<std::string>    uniqueLots;    // 使用集合去重
+    return getLotEligibility(getAllEquipments()).lots;
+}
+
+LotEligibility ScheduleDataManagerImpl::getLotEligibility(const std::vector<std::string> &equipments)
+{
+    std::vector<std::pair<std::string, std::string>> rows;
 
     try {
-        // 获取所有设备
-        auto equipments = getAllEquipments();
-
-        // 对每个设备获取批次，并去重
-        for (const auto &eqp: equipments) {
-            auto eqpLots = getLotsByEquipment(eqp);
-            for (const auto &lot: eqpLots) {
-                uniqueLots.insert(lot);
+        if (!fetchLotEqpRelation(rows)) {
+            std::cerr << "Query not found: getLotEqpRelation, falling back to getLotListByEqpId per equipment ("
+                      << equipments.size() << " queries)" << std::endl;
+
+            // 每台设备一次查询，按连接池上限并发
+            std::vector<std::vector<std::string>> lotsByEquipment(equipments.size());
+
+            auto   it     = m_queries.find("getLotListByEqpId");
+            size_t shards = it == m_queries.end() ? 1 : concurrencyOf(it->second.dataSource);
+            runSharded(equipments.size(), shards, [&](size_t begin, size_t end) {
+                for (size_t j = begin; j < end; ++j) {
+                    lotsByEquipment[j] = getLotsByEquipment(equipments[j]);
+                }
+            });
+
+            for (size_t j = 0; j < equipments.size(); ++j) {
+                for (auto &lot: lotsByEquipment[j]) {
+                    rows.emplace_back(std::move(lot), equipments[j]);
+                }
             }
         }
-
-        lots.assign(uniqueLots.begin(), uniqueLots.end());
     }
     catch (const std::exception &e) {
-        std::cerr << "Failed to get all lots: " << e.what() << std::endl;
+        std::cerr << "Failed to get lot eligibility: " << e.what() << std::endl;
+        ++m_queryFailures;
     }
 
-    return lots;
+    return buildLotEligibility(rows, equipments);
 }
 
-double ScheduleDataManagerImpl::getProcessTime(const std::string &equipmentId, const std::string &lotId)
+bool ScheduleDataManagerImpl::fetchProcessTimesByLot(const std::string &lotId, std::vector<std::pair<std::string, double>> &rows)
 {
-    try {
-        auto it = m_queries.find("getProcessTime");
-        if (it == m_queries.end()) {
-            throw std::runtime_error("Query not found: getProcessTime");
+    auto it = m_queries.find("getProcessTimeByLot");
+    if (it == m_queries.end()) {
+        return false;
+    }
+
+    const QueryInfo &query   = it->second;
+    auto             session = getSession(query.dataSource);
+    if (!session) {
+        throw std::runtime_error("Failed to get database session");
+    }
+
+    std::vector<std::string> eqpIds(kDeltaFetchRows);
+    std::vector<double>      times(kDeltaFetchRows);
+    std::vector<indicator>   timeIndicators(kDeltaFetchRows);
+
+    rows.clear();
+    statement &stmt = session->bind(query.id, query.sql, use(lotId), into(eqpIds), into(times, timeIndicators));
+    stmt.execute();
+    while (stmt.fetch()) {
+        for (size_t k = 0; k < eqpIds.size(); ++k) {
+            if (timeIndicators[k] != i_null && times[k] > 0) {
+                rows.emplace_back(eqpIds[k], times[k]);
+            }
         }
 
-        const QueryInfo &query   = it->second;
-        auto             session = getSession(query.dataSource);
-        if (!session) {
-            throw std::runtime_error("Failed to get database session");
+        eqpIds.resize(kDeltaFetchRows);
+        times.resize(kDeltaFetchRows);
+        timeIndicators.resize(kDeltaFetchRows);
+    }
+    return true;
+}
+
+bool ScheduleDataManagerImpl::fetchLotEqpRelation(std::vector<std::pair<std::string, std::string>> &rows)
+{
+    auto it = m_queries.find("getLotEqpRelation");
+    if (it == m_queries.end()) {
+        return false;
+    }
+
+    const QueryInfo &query   = it->second;
+    auto             session = getSession(query.dataSource);
+    if (!session) {
+        throw std::runtime_error("Failed to get database session");
+    }
+
+    // 一次取回所有(批次, 设备)关系，结果列依次为批次ID、设备ID
+    std::vector<std::string> lotIds(kRelationFetchRows);
+    std::vector<std::string> eqpIds(kRelationFetchRows);
+
+    statement &stmt = session->bind(query.id, query.sql, into(lotIds), into(eqpIds));
+    stmt.execute();
+    while (stmt.fetch()) {
+        for (size_t k = 0; k < lotIds.size(); ++k) {
+            rows.emplace_back(std::move(lotIds[k]), std::move(eqpIds[k]));
         }
 
-        double    processTime = 0.0;
-        indicator ind;
+        lotIds.resize(kRelationFetchRows);
+        eqpIds.resize(kRelationFetchRows);
+    }
 
-        // 使用正确的SOCI API方式执行参数化查询并获取结果
-        *session << query.sql, use(equipmentId), use(lotId), into(processTime, ind);
+    return true;
+}
 
-        if (ind == i_null) {
-            return 0.0;    // 如果结果为NULL，返回0
+LotEligibility ScheduleDataManagerImpl::buildLotEligibility(
+  const std::vector<std::pair<std::string, std::string>> &rows,
+  const std::vector<std::string>                         &equipments)
+{
+    std::unordered_map<std::string, size_t> equipmentIndexMap;
+    for (size_t i = 0; i < equipments.size(); ++i) {
+        equipmentIndexMap[equipments[i]] = i;
+    }
+
+    // 批次ID到可加工设备下标，按ID排序
+    std::map<std::string, std::vector<size_t>> relation;
+    for (const auto &[lot, eqp]: rows) {
+        auto eqpIt = equipmentIndexMap.find(eqp);
+        if (eqpIt != equipmentIndexMap.end()) {
+            relation[lot].push_back(eqpIt->second);
         }
+    }
+
+    LotEligibility eligibility;
+    eligibility.lots.reserve(relation.size());
+    eligibility.equipments.reserve(relation.size());
+    for (auto &[lot, eqps]: relation) {
+        // 关系表中同一配对可能出现多次
+        std::sort(eqps.begin(), eqps.end());
+        eqps.erase(std::unique(eqps.begin(), eqps.end()), eqps.end());
+
+        eligibility.lots.push_back(lot);
+        eligibility.equipments.push_back(std::move(eqps));
+    }
+
+    return eligibility;
+}
+
+double ScheduleDataManagerImpl::queryProcessTime(const std::string &equipmentId, const std::string &lotId)
+{
+    auto it = m_queries.find("getProcessTime");
+    if (it == m_queries.end()) {
+        throw std::runtime_error("Query not found: getProcessTime");
+    }
+
+    const QueryInfo &query   = it->second;
+    auto             session = getSession(query.dataSource);
+    if (!session) {
+        throw std::runtime_error("Failed to get database session");
+    }
+
+    double    processTime = 0.0;
+    indicator ind         = i_ok;
+
+    // 逐对查询的热点路径，复用每个会话上已准备的语句
+    bool found = session->bind(query.id, query.sql, use(equipmentId), use(lotId), into(processTime, ind)).execute(true);
+
+    if (!found || ind == i_null) {
+        return 0.0;    // 没有记录或结果为NULL，返回0
+    }
+
+    return processTime;
+}
 
-        return processTime;
+double ScheduleDataManagerImpl::getProcessTime(const std::string &equipmentId, const std::string &lotId)
+{
+    try {
+        return queryProcessTime(equipmentId, lotId);
     }
     catch (const std::exception &e) {
         std::cerr << "Failed to get process time: " << e.what() << std::endl;
+        ++m_queryFailures;
         return 0.0;
     }
 }
 
+std::map<std::string, double> ScheduleDataManagerImpl::getProcessTimesByLot(
+  const std::string              &lotId,
+  const std::vector<std::string> &equipments)
+{
+    std::map<std::string, double> times;
+    try {
+        std::vector<std::pair<std::string, double>> rows;
+        if (fetchProcessTimesByLot(lotId, rows)) {
+            std::set<std::string> wanted(equipments.begin(), equipments.end());
+            for (const auto &row: rows) {
+                if (wanted.count(row.first) > 0) {
+                    times[row.first] = row.second;
+                }
+            }
+            return times;
+        }
+
+        for (const auto &eqpId: equipments) {
+            double time = queryProcessTime(eqpId, lotId);
+            if (time > 0) {
+                times[eqpId] = time;
+            }
+        }
+        return times;
+    }
+    catch (const std::exception &e) {
+        std::cerr << "Failed to get process times of lot " << lotId << ": " << e.what() << std::endl;
+        return {};
+    }
+}
+
 std::vector<std::vector<double>> ScheduleDataManagerImpl::getProcessTimeMatrix(
   const std::vector<std::string> &lots,
   const std::vector<std::string> &equipments)
+{
+    return buildProcessTimeMatrix(lots, equipments, nullptr);
+}
+
+std::vector<std::vector<double>> ScheduleDataManagerImpl::getProcessTimeMatrix(
+  const LotEligibility           &eligibility,
+  const std::vector<std::string> &equipments)
+{
+    return buildProcessTimeMatrix(eligibility.lots, equipments, &eligibility);
+}
+
+std::vector<std::vector<double>> ScheduleDataManagerImpl::buildProcessTimeMatrix(
+  const std::vector<std::string> &lots,
+  const std::vector<std::string> &equipments,
+  const LotEligibility           *eligibility)
 {
     std::vector<std::vector<double>> matrix(lots.size(), std::vector<double>(equipments.size(), 0.0));
 
@@ -364,49 +728,504 @@ std::vector<std::vector<double>> ScheduleDataManagerImpl::getProcessTimeMatrix(
         equipmentIndexMap[equipments[i]] = i;
     }
 
+    // 配置了集合查询时一次取回所有(批次, 设备, 处理时间)；删除该查询才逐对查询，每对一次数据库往返
+    auto it = m_queries.find("getProcessTimeMatrix");
+    if (it == m_queries.end()) {
+        auto   pairQuery = m_queries.find("getProcessTime");
+        size_t shards    = pairQuery == m_queries.end() ? 1 : concurrencyOf(pairQuery->second.dataSource);
+
+        // 按批次分段并发查询，各段只写自己的行
+        if (eligibility) {
+            // 只查询可加工配对
+            size_t pairs = 0;
+            for (const auto &eqps: eligibility->equipments) {
+                pairs += eqps.size();
+            }
+            std::cerr << "Query not found: getProcessTimeMatrix, falling back to per-pair getProcessTime ("
+                      << pairs << " queries)" << std::endl;
+
+            runSharded(lots.size(), shards, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    for (size_t j: eligibility->equipments[i]) {
+                        matrix[i][j] = getProcessTime(equipments[j], lots[i]);
+                    }
+                }
+            });
+            return matrix;
+        }
+
+        std::cerr << "Query not found: getProcessTimeMatrix, falling back to per-pair getProcessTime ("
+                  << lots.size() * equipments.size() << " queries)" << std::endl;
+
+        runSharded(lots.size(), shards, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                for (size_t j = 0; j < equipments.size(); ++j) {
+                    matrix[i][j] = getProcessTime(equipments[j], lots[i]);
+                }
+            }
+        });
+        return matrix;
+    }
+
+    try {
+        const QueryInfo &query = it->second;
+        auto             start = std::chrono::steady_clock::now();
+        size_t           rows  = 0;
+
+        if (query.params.size() == 2 && !equipments.empty()) {
+            // 查询带分片数和分片号参数时，每个分片用池中的一个会话并发查询。
+            // 分片在SQL中按设备ID的散列取模划分，不依赖客户端与数据库的字符串排序规则一致，
+            // 各分片的设备互不重叠且合起来覆盖全部行，只写矩阵中各自的列
+            size_t shards = std::min(concurrencyOf(query.dataSource), equipments.size());
+
+            std::vector<std::pair<int, int>> shardParams;
+            for (size_t s = 0; s < shards; ++s) {
+                shardParams.emplace_back(static_cast<int>(shards), static_cast<int>(s));
+            }
+
+            std::vector<size_t> shardRows(shards, 0);
+            runSharded(shards, shards, [&](size_t begin, size_t end) {
+                for (size_t s = begin; s < end; ++s) {
+                    shardRows[s] = loadProcessTimeMatrix(query, lotIndexMap, equipmentIndexMap, matrix, &shardParams[s]);
+                }
+            });
+            for (size_t count: shardRows) {
+                rows += count;
+            }
+        }
+        else {
+            rows = loadProcessTimeMatrix(query, lotIndexMap, equipmentIndexMap, matrix);
+        }
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Loaded process time matrix: " << rows << " rows in " << elapsed.count() << " ms" << std::endl;
+    }
+    catch (const std::exception &e) {
+        std::cerr << "获取处理时间矩阵出错: " << e.what() << std::endl;
+        ++m_queryFailures;
+    }
+
+    return matrix;
+}
+
+size_t ScheduleDataManagerImpl::loadProcessTimeMatrix(
+  const QueryInfo                               &query,
+  const std::unordered_map<std::string, size_t> &lotIndexMap,
+  const std::unordered_map<std::string, size_t> &equipmentIndexMap,
+  std::vector<std::vector<double>>              &matrix,
+  const std::pair<int, int>                     *shard)
+{
+    auto session = getSession(query.dataSource);
+    if (!session) {
+        throw std::runtime_error("Failed to get database session");
+    }
+
+    // 按列批量取回，结果列依次为批次ID、设备ID、处理时间
+    std::vector<std::string> lotIds(kProcessTimeFetchRows);
+    std::vector<std::string> eqpIds(kProcessTimeFetchRows);
+    std::vector<double>      times(kProcessTimeFetchRows);
+    std::vector<indicator>   timeIndicators(kProcessTimeFetchRows);
+
+    statement &stmt = shard
+                      ? session->bind(query.id, query.sql, into(lotIds), into(eqpIds), into(times, timeIndicators), use(shard->first), use(shard->second))
+                      : session->bind(query.id, query.sql, into(lotIds), into(eqpIds), into(times, timeIndicators));
+    stmt.execute();
+
+    size_t rows = 0;
+    while (stmt.fetch()) {
+        for (size_t k = 0; k < lotIds.size(); ++k) {
+            auto lotIt = lotIndexMap.find(lotIds[k]);
+            auto eqpIt = equipmentIndexMap.find(eqpIds[k]);
+
+            // 不在本轮批次和设备范围内的行直接跳过
+            if (lotIt != lotIndexMap.end() && eqpIt != equipmentIndexMap.end() && timeIndicators[k] != i_null) {
+                matrix[lotIt->second][eqpIt->second] = times[k];
+            }
+        }
+        rows += lotIds.size();
+
+        // fetch会把向量缩小为实际取回的行数，下一批前恢复容量
+        lotIds.resize(kProcessTimeFetchRows);
+        eqpIds.resize(kProcessTimeFetchRows);
+        times.resize(kProcessTimeFetchRows);
+        timeIndicators.resize(kProcessTimeFetchRows);
+    }
+
+    return rows;
+}
+
+const MasterDataSnapshot &ScheduleDataManagerImpl::refreshSnapshot(bool fullReload)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    if (!m_hasSnapshot || fullReload || !hasSnapshotDeltaQueries()) {
+        if (!loadFullSnapshot()) {
+            return m_snapshot;
+        }
+    }
+    else {
+        try {
+            long long previous = m_snapshot.version;
+            if (applySnapshotDelta()) {
+                rebuildSnapshot();
+            }
+
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            std::cout << "Snapshot delta applied: version " << previous << " -> " << m_snapshot.version
+                      << " in " << elapsed.count() << " ms" << std::endl;
+            return m_snapshot;
+        }
+        catch (const std::exception &e) {
+            std::cerr << "Failed to apply snapshot delta, reloading all master data: " << e.what() << std::endl;
+            if (!loadFullSnapshot()) {
+                return m_snapshot;
+            }
+        }
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Snapshot fully loaded: version " << m_snapshot.version << " in " << elapsed.count() << " ms" << std::endl;
+    return m_snapshot;
+}
+
+bool ScheduleDataManagerImpl::hasSnapshotDeltaQueries() const
+{
+    for (const char *id: {"getDataVersion", "getEqpListDelta", "getLotEqpRelationDelta", "getProcessTimeDelta"}) {
+        if (m_queries.find(id) == m_queries.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+long long ScheduleDataManagerImpl::queryDataVersion()
+{
+    auto it = m_queries.find("getDataVersion");
+    if (it == m_queries.end()) {
+        return 0;
+    }
+
+    const QueryInfo &query   = it->second;
+    auto             session = getSession(query.dataSource);
+    if (!session) {
+        throw std::runtime_error("Failed to get database session");
+    }
+
+    long long version = 0;
+    indicator ind     = i_ok;
+    bool      found   = session->bind(query.id, query.sql, into(version, ind)).execute(true);
+    return !found || ind == i_null ? 0 : version;
+}
+
+bool ScheduleDataManagerImpl::loadFullSnapshot()
+{
+    const size_t failures = m_queryFailures.load();
+
+    // 先取版本号再加载：加载期间发生的变更版本号更大，下一轮增量会再次应用（覆盖写是幂等的）
+    long long version = 0;
+    try {
+        version = queryDataVersion();
+    }
+    catch (const std::exception &e) {
+        std::cerr << "Failed to get data version: " << e.what() << std::endl;
+        ++m_queryFailures;
+    }
+
+    // 设备列表和批次关系互不依赖，在两个会话上同时查询
+    auto equipmentsFuture = std::async(std::launch::async, [this]() { return getAllEquipments(); });
+
+    std::vector<std::pair<std::string, std::string>> relationRows;
+    bool                                             hasRelation = false;
     try {
-        // 一次性获取所有工艺兼容性数据
-        auto session = getSession("Oracle");    // 假设兼容性数据在Oracle数据库
+        hasRelation = fetchLotEqpRelation(relationRows);
+    }
+    catch (const std::exception &e) {
+        std::cerr << "Failed to get lot eligibility: " << e.what() << std::endl;
+        ++m_queryFailures;
+        hasRelation = true;
+    }
+
+    std::vector<std::string>         equipments  = equipmentsFuture.get();
+    LotEligibility                   eligibility = hasRelation ? buildLotEligibility(relationRows, equipments)
+                                                               : getLotEligibility(equipments);
+    std::vector<std::vector<double>> matrix      = getProcessTimeMatrix(eligibility, equipments);
+
+    // 部分查询失败时结果缺少设备、批次或处理时间，提交后只会增量更新而一直缺失，保留原快照并在下一轮重新全量加载
+    if (m_queryFailures.load() != failures) {
+        std::cerr << "Master data load incomplete, keeping the previous snapshot until the next full reload" << std::endl;
+        m_hasSnapshot = false;
+        return false;
+    }
+
+    m_relation.clear();
+    m_times.clear();
+    for (size_t i = 0; i < eligibility.lots.size(); ++i) {
+        const std::string &lot = eligibility.lots[i];
+
+        auto &eqps = m_relation[lot];
+        for (size_t j: eligibility.equipments[i]) {
+            eqps.insert(equipments[j]);
+        }
+
+        for (size_t j = 0; j < equipments.size(); ++j) {
+            if (matrix[i][j] > 0) {
+                m_times[lot][equipments[j]] = matrix[i][j];
+            }
+        }
+    }
+
+    m_snapshot.equipments      = std::move(equipments);
+    m_snapshot.lots            = std::move(eligibility.lots);
+    m_snapshot.processingTimes = std::move(matrix);
+    m_snapshot.version         = version;
+    m_hasSnapshot              = true;
+    return true;
+}
+
+bool ScheduleDataManagerImpl::applySnapshotDelta()
+{
+    const long long since   = m_snapshot.version;
+    long long       version = since;
+    size_t          changes = 0;
+
+    auto sessionFor = [this](const QueryInfo &query) {
+        auto session = getSession(query.dataSource);
         if (!session) {
             throw std::runtime_error("Failed to get database session");
         }
+        return session;
+    };
+
+    // 各查询的变更行先暂存，全部查询成功后才一起应用到快照和稀疏副本；
+    // 中途失败时快照保持上一次一致的状态（设备列表与处理时间矩阵的列对应）
+    std::vector<std::pair<std::string, bool>>                 eqpChanges;         // 设备ID, 是否删除
+    std::vector<std::tuple<std::string, std::string, bool>>   relationChanges;    // 批次ID, 设备ID, 是否删除
+    std::vector<std::tuple<std::string, std::string, double>> timeChanges;        // 批次ID, 设备ID, 处理时间（不大于0表示删除）
+
+    // 设备变更：EQP_ID, DELETED, VERSION
+    {
+        const QueryInfo &query   = m_queries.at("getEqpListDelta");
+        auto             session = sessionFor(query);
+
+        std::vector<std::string> eqpIds(kDeltaFetchRows);
+        std::vector<int>         deleted(kDeltaFetchRows);
+        std::vector<long long>   versions(kDeltaFetchRows);
+
+        statement &stmt = session->bind(query.id, query.sql, use(since), into(eqpIds), into(deleted), into(versions));
+        stmt.execute();
+        while (stmt.fetch()) {
+            for (size_t k = 0; k < eqpIds.size(); ++k) {
+                eqpChanges.emplace_back(eqpIds[k], deleted[k] != 0);
+                version = std::max(version, versions[k]);
+            }
+            changes += eqpIds.size();
 
-        for (size_t i = 0; i < lots.size(); ++i) {
-            for (size_t j = 0; j < equipments.size(); ++j) {
-                matrix[i][j] = getProcessTime(equipments[j], lots[i]);
+            eqpIds.resize(kDeltaFetchRows);
+            deleted.resize(kDeltaFetchRows);
+            versions.resize(kDeltaFetchRows);
+        }
+    }
+
+    // 批次与设备关系变更：LOT_ID, EQP_ID, DELETED, VERSION
+    // 处理时间表中已有的行版本号可能早于批次出现的时间，新增配对的处理时间要单独补查
+    std::vector<std::pair<std::string, std::string>> addedPairs;
+    {
+        const QueryInfo &query   = m_queries.at("getLotEqpRelationDelta");
+        auto             session = sessionFor(query);
+
+        std::vector<std::string> lotIds(kDeltaFetchRows);
+        std::vector<std::string> eqpIds(kDeltaFetchRows);
+        std::vector<int>         deleted(kDeltaFetchRows);
+        std::vector<long long>   versions(kDeltaFetchRows);
+
+        statement &stmt = session->bind(query.id, query.sql, use(since), into(lotIds), into(eqpIds), into(deleted), into(versions));
+        stmt.execute();
+        while (stmt.fetch()) {
+            for (size_t k = 0; k < lotIds.size(); ++k) {
+                if (!deleted[k]) {
+                    auto lotIt = m_relation.find(lotIds[k]);
+                    if (lotIt == m_relation.end() || lotIt->second.count(eqpIds[k]) == 0) {
+                        addedPairs.emplace_back(lotIds[k], eqpIds[k]);
+                    }
+                }
+                relationChanges.emplace_back(lotIds[k], eqpIds[k], deleted[k] != 0);
+                version = std::max(version, versions[k]);
             }
+            changes += lotIds.size();
+
+            lotIds.resize(kDeltaFetchRows);
+            eqpIds.resize(kDeltaFetchRows);
+            deleted.resize(kDeltaFetchRows);
+            versions.resize(kDeltaFetchRows);
         }
+    }
 
-        // // 修复: 使用正确方式创建rowset
-        // rowset<row> rs = (session->prepare << "SELECT LOT_ID, EQP_ID, PROCESS_TIME FROM PROCESS_COMPATIBILITY WHERE PROCESS_TIME > 0");
+    // 处理时间变更：LOT_ID, EQP_ID, PROCESS_TIME, VERSION，处理时间为NULL或不大于0表示删除
+    std::set<std::pair<std::string, std::string>> timedPairs;    // 本次变更中有处理时间的配对
+    {
+        const QueryInfo &query   = m_queries.at("getProcessTimeDelta");
+        auto             session = sessionFor(query);
+
+        std::vector<std::string> lotIds(kDeltaFetchRows);
+        std::vector<std::string> eqpIds(kDeltaFetchRows);
+        std::vector<double>      times(kDeltaFetchRows);
+        std::vector<indicator>   timeIndicators(kDeltaFetchRows);
+        std::vector<long long>   versions(kDeltaFetchRows);
+
+        statement &stmt = session->bind(query.id, query.sql, use(since), into(lotIds), into(eqpIds), into(times, timeIndicators), into(versions));
+        stmt.execute();
+        while (stmt.fetch()) {
+            for (size_t k = 0; k < lotIds.size(); ++k) {
+                double time = timeIndicators[k] != i_null && times[k] > 0 ? times[k] : 0.0;
+                if (time > 0) {
+                    timedPairs.emplace(lotIds[k], eqpIds[k]);
+                }
+                timeChanges.emplace_back(lotIds[k], eqpIds[k], time);
+                version = std::max(version, versions[k]);
+            }
+            changes += lotIds.size();
 
-        // // 填充处理时间矩阵
-        // for (const auto &r: rs) {
-        //     std::string lotId       = r.get<std::string>("LOT_ID");
-        //     std::string eqpId       = r.get<std::string>("EQP_ID");
-        //     double      processTime = r.get<double>("PROCESS_TIME");
+            lotIds.resize(kDeltaFetchRows);
+            eqpIds.resize(kDeltaFetchRows);
+            times.resize(kDeltaFetchRows);
+            timeIndicators.resize(kDeltaFetchRows);
+            versions.resize(kDeltaFetchRows);
+        }
+    }
 
-        //     auto lotIt = lotIndexMap.find(lotId);
-        //     auto eqpIt = equipmentIndexMap.find(eqpId);
+    // 补查新增配对中仍没有处理时间的
+    std::vector<std::pair<std::string, std::string>> missingPairs;
+    for (const auto &pair: addedPairs) {
+        auto lotIt = m_times.find(pair.first);
+        if (timedPairs.count(pair) == 0 && (lotIt == m_times.end() || lotIt->second.count(pair.second) == 0)) {
+            missingPairs.push_back(pair);
+        }
+    }
+    std::vector<double> missingTimes(missingPairs.size(), 0.0);
 
-        //     if (lotIt != lotIndexMap.end() && eqpIt != equipmentIndexMap.end()) {
-        //         matrix[lotIt->second][eqpIt->second] = processTime;
-        //     }
-        // }
+    if (m_queries.count("getProcessTimeByLot") > 0) {
+        // 每个批次一次集合查询，查询次数与新增配对涉及的批次数成正比，按连接池上限并发；失败时抛出，改为全量加载
+        std::map<std::string, std::vector<size_t>> pairsByLot;
+        for (size_t k = 0; k < missingPairs.size(); ++k) {
+            pairsByLot[missingPairs[k].first].push_back(k);
+        }
+        std::vector<const std::pair<const std::string, std::vector<size_t>> *> lots;
+        for (const auto &entry: pairsByLot) {
+            lots.push_back(&entry);
+        }
+
+        size_t shards = concurrencyOf(m_queries.at("getProcessTimeByLot").dataSource);
+        runSharded(lots.size(), shards, [&](size_t begin, size_t end) {
+            std::vector<std::pair<std::string, double>> rows;
+            for (size_t l = begin; l < end; ++l) {
+                fetchProcessTimesByLot(lots[l]->first, rows);
+                std::unordered_map<std::string, double> byEqp(rows.begin(), rows.end());
+                for (size_t k: lots[l]->second) {
+                    auto timeIt     = byEqp.find(missingPairs[k].second);
+                    missingTimes[k] = timeIt == byEqp.end() ? 0.0 : timeIt->second;
+                }
+            }
+        });
     }
-    catch (const std::exception &e) {
-        std::cerr << "获取处理时间矩阵出错: " << e.what() << std::endl;
-        // std::cerr << "将使用单独查询方式获取" << std::endl;
+    else {
+        // 逐对查询，查询次数与新增配对数成正比
+        auto         pairQuery = m_queries.find("getProcessTime");
+        size_t       shards    = pairQuery == m_queries.end() ? 1 : concurrencyOf(pairQuery->second.dataSource);
+        const size_t failures  = m_queryFailures.load();
+        runSharded(missingPairs.size(), shards, [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                missingTimes[k] = getProcessTime(missingPairs[k].second, missingPairs[k].first);
+            }
+        });
 
-        // 回退到单独查询每个处理时间的方式
-        // for (size_t i = 0; i < lots.size(); ++i) {
-        //     for (size_t j = 0; j < equipments.size(); ++j) {
-        //         matrix[i][j] = getProcessTime(equipments[j], lots[i]);
-        //     }
-        // }
+        // 查询失败的配对会被当作不可加工，改为全量加载
+        if (m_queryFailures.load() != failures) {
+            throw std::runtime_error("failed to look up process times of added pairs");
+        }
     }
 
-    return matrix;
+    // 所有查询都已成功，按查询顺序应用变更
+    auto &equipments = m_snapshot.equipments;
+    for (const auto &[eqpId, deleted]: eqpChanges) {
+        auto eqpIt = std::find(equipments.begin(), equipments.end(), eqpId);
+        if (deleted && eqpIt != equipments.end()) {
+            equipments.erase(eqpIt);
+        }
+        else if (!deleted && eqpIt == equipments.end()) {
+            equipments.push_back(eqpId);
+        }
+    }
+
+    for (const auto &[lotId, eqpId, deleted]: relationChanges) {
+        if (!deleted) {
+            m_relation[lotId].insert(eqpId);
+            continue;
+        }
+        auto lotIt = m_relation.find(lotId);
+        if (lotIt != m_relation.end()) {
+            lotIt->second.erase(eqpId);
+            if (lotIt->second.empty()) {
+                m_relation.erase(lotIt);
+            }
+        }
+    }
+
+    for (const auto &[lotId, eqpId, time]: timeChanges) {
+        if (time > 0) {
+            m_times[lotId][eqpId] = time;
+            continue;
+        }
+        auto lotIt = m_times.find(lotId);
+        if (lotIt != m_times.end()) {
+            lotIt->second.erase(eqpId);
+        }
+    }
+
+    for (size_t k = 0; k < missingPairs.size(); ++k) {
+        if (missingTimes[k] > 0) {
+            m_times[missingPairs[k].first][missingPairs[k].second] = missingTimes[k];
+        }
+    }
+
+    m_snapshot.version = version;
+    std::cout << "Snapshot delta: " << changes << " changed rows since version " << since << std::endl;
+    return changes > 0;
+}
+
+void ScheduleDataManagerImpl::rebuildSnapshot()
+{
+    const auto &equipments = m_snapshot.equipments;
+
+    std::unordered_map<std::string, size_t> equipmentIndexMap;
+    for (size_t j = 0; j < equipments.size(); ++j) {
+        equipmentIndexMap[equipments[j]] = j;
+    }
+
+    // 与全量加载一致：批次按ID排序，只保留至少有一台现有设备可加工的批次
+    m_snapshot.lots.clear();
+    m_snapshot.processingTimes.clear();
+    for (const auto &[lot, eqps]: m_relation) {
+        bool eligible = std::any_of(eqps.begin(), eqps.end(), [&equipmentIndexMap](const std::string &eqp) {
+            return equipmentIndexMap.count(eqp) > 0;
+        });
+        if (!eligible) {
+            continue;
+        }
+
+        std::vector<double> row(equipments.size(), 0.0);
+        auto                timesIt = m_times.find(lot);
+        if (timesIt != m_times.end()) {
+            for (const auto &[eqp, time]: timesIt->second) {
+                auto eqpIt = equipmentIndexMap.find(eqp);
+                if (eqpIt != equipmentIndexMap.end()) {
+                    row[eqpIt->second] = time;
+                }
+            }
+        }
+
+        m_snapshot.lots.push_back(lot);
+        m_snapshot.processingTimes.push_back(std::move(row));
+    }
 }
 
 bool ScheduleDataManagerImpl::saveDispatchResult(
@@ -431,10 +1250,7 @@ bool ScheduleDataManagerImpl::saveDispatchResult(
             return false;
         }
 
-        // 正确使用SOCI参数绑定语法
-        *session << query.sql,
-          use(equipmentId), use(lotId), use(releaseTime),
-          use(startTime), use(endTime);
+        session->bind(query.id, query.sql, use(equipmentId), use(lotId), use(releaseTime), use(startTime), use(endTime)).execute(true);
 
         return true;
     }
@@ -447,8 +1263,6 @@ bool ScheduleDataManagerImpl::saveDispatchResult(
 bool ScheduleDataManagerImpl::saveDispatchResults(
   const std::vector<std::tuple<std::string, std::string, double, double, double>> &results)
 {
-    bool success = true;
-
     // 获取查询信息提前
     auto it = m_queries.find("insertDispatch");
     if (it == m_queries.end()) {
@@ -463,34 +1277,238 @@ bool ScheduleDataManagerImpl::saveDispatchResults(
         return false;
     }
 
+    if (results.empty()) {
+        return true;
+    }
+
+    // 按列绑定的参数数组
+    std::vector<std::string> eqpIds;
+    std::vector<std::string> lotIds;
+    std::vector<double>      releaseTimes;
+    std::vector<double>      startTimes;
+    std::vector<double>      endTimes;
+
+    auto fill = [&](size_t first, size_t count) {
+        for (size_t k = 0; k < count; ++k) {
+            const auto &[eqpId, lotId, releaseTime, startTime, endTime] = results[first + k];
+
+            eqpIds[k]       = eqpId;
+            lotIds[k]       = lotId;
+            releaseTimes[k] = releaseTime;
+            startTimes[k]   = startTime;
+            endTimes[k]     = endTime;
+        }
+    };
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+
+        // 整个发布在一个事务内，任何一批失败都回滚，服务端看不到写了一半的结果
+        transaction tr(*session);
+        size_t      batches = executeInBatches(
+          *session, query.id, query.sql, results.size(), m_dispatchBatchSize, fill, eqpIds, lotIds, releaseTimes, startTimes, endTimes);
+        tr.commit();
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Inserted " << results.size() << " dispatch rows in " << batches << " batches in "
+                  << elapsed.count() << " ms" << std::endl;
+        return true;
+    }
+    catch (const std::exception &e) {
+        // transaction析构时未提交会自动回滚
+        std::cerr << "Batch insert failed, release rolled back: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool ScheduleDataManagerImpl::saveDispatchDiff(
+  const std::vector<std::tuple<std::string, std::string, double, double, double>> &results,
+  double                                                                           releaseTime)
+{
+    if (!hasDispatchDiffQueries()) {
+        std::cerr << "Dispatch diff queries not configured, inserting the full plan" << std::endl;
+        return saveDispatchResults(results);
+    }
+
+    const QueryInfo &insertQuery = m_queries.at("insertDispatch");
+    auto             session     = getSession(insertQuery.dataSource);
+    if (!session) {
+        std::cerr << "Failed to get database session for " << insertQuery.dataSource << std::endl;
+        return false;
+    }
+
     try {
-        // 优化：准备一次语句，多次执行
-        statement stmt = (session->prepare << query.sql);
-
-        for (const auto &[eqpId, lotId, releaseTime, startTime, endTime]: results) {
-            try {
-                // 绑定参数并执行
-                stmt.exchange(use(eqpId));
-                stmt.exchange(use(lotId));
-                stmt.exchange(use(releaseTime));
-                stmt.exchange(use(startTime));
-                stmt.exchange(use(endTime));
-
-                stmt.define_and_bind();
-                stmt.execute(true);
+        auto start = std::chrono::steady_clock::now();
+
+        // 重启后第一次写入前与数据库中的计划对齐
+        if (!m_hasPublished) {
+            loadPublishedDispatch(*session);
+        }
+
+        // 与已发布计划按批次比较；有重复行的批次先删除再插入一行，计为更新
+        std::vector<size_t>      inserts;
+        std::vector<size_t>      updates;
+        std::vector<std::string> deletes;
+        size_t                   rewrites = 0;
+
+        std::unordered_map<std::string, size_t> current;
+        current.reserve(results.size());
+        for (size_t k = 0; k < results.size(); ++k) {
+            const auto &[eqpId, lotId, release, startTime, endTime] = results[k];
+            current[lotId] = k;
+
+            auto it = m_published.find(lotId);
+            if (m_duplicateLots.count(lotId) > 0) {
+                deletes.push_back(lotId);
+                inserts.push_back(k);
+                ++rewrites;
+            }
+            else if (it == m_published.end()) {
+                inserts.push_back(k);
+            }
+            else if (it->second.equipmentId != eqpId
+                     || std::abs(it->second.startTime - startTime) > kDispatchTimeEpsilon
+                     || std::abs(it->second.endTime - endTime) > kDispatchTimeEpsilon) {
+                updates.push_back(k);
             }
-            catch (const std::exception &e) {
-                std::cerr << "Error executing statement: " << e.what() << std::endl;
-                success = false;
+        }
+        for (const auto &[lotId, published]: m_published) {
+            if (current.count(lotId) == 0) {
+                deletes.push_back(lotId);
+            }
+        }
+
+        std::vector<std::string> eqpIds;
+        std::vector<std::string> lotIds;
+        std::vector<double>      releaseTimes;
+        std::vector<double>      startTimes;
+        std::vector<double>      endTimes;
+
+        // 按下标列表填充插入和更新的参数数组
+        auto fillRows = [&](const std::vector<size_t> &rows) {
+            return [&, indices = &rows](size_t first, size_t count) {
+                for (size_t k = 0; k < count; ++k) {
+                    const auto &[eqpId, lotId, release, startTime, endTime] = results[(*indices)[first + k]];
+
+                    eqpIds[k]       = eqpId;
+                    lotIds[k]       = lotId;
+                    releaseTimes[k] = releaseTime;
+                    startTimes[k]   = startTime;
+                    endTimes[k]     = endTime;
+                }
+            };
+        };
+        auto fillDeletes = [&](size_t first, size_t count) {
+            std::copy_n(deletes.begin() + first, count, lotIds.begin());
+        };
+
+        // 删除、更新、插入和发布头在同一个事务内，服务端只会看到完整的新计划
+        transaction tr(*session);
+
+        const QueryInfo &deleteQuery = m_queries.at("deleteDispatch");
+        const QueryInfo &updateQuery = m_queries.at("updateDispatch");
+        executeInBatches(*session, deleteQuery.id, deleteQuery.sql, deletes.size(), m_dispatchBatchSize, fillDeletes, lotIds);
+        executeInBatches(
+          *session, updateQuery.id, updateQuery.sql, updates.size(), m_dispatchBatchSize, fillRows(updates),
+          eqpIds, releaseTimes, startTimes, endTimes, lotIds);
+        executeInBatches(
+          *session, insertQuery.id, insertQuery.sql, inserts.size(), m_dispatchBatchSize, fillRows(inserts),
+          eqpIds, lotIds, releaseTimes, startTimes, endTimes);
+
+        long long version  = m_releaseVersion + 1;
+        int       inserted = static_cast<int>(inserts.size() - rewrites);
+        int       updated  = static_cast<int>(updates.size() + rewrites);
+        int       deleted  = static_cast<int>(deletes.size() - rewrites);
+        int       total    = static_cast<int>(results.size());
+        const QueryInfo &releaseQuery = m_queries.at("insertDispatchRelease");
+        session->bind(releaseQuery.id, releaseQuery.sql, use(version), use(releaseTime), use(inserted), use(updated), use(deleted), use(total))
+          .execute(true);
+
+        tr.commit();
+
+        // 提交成功后才更新已发布计划
+        for (const auto &lotId: deletes) {
+            m_published.erase(lotId);
+        }
+        for (const auto *rows: {&inserts, &updates}) {
+            for (size_t k: *rows) {
+                const auto &[eqpId, lotId, release, startTime, endTime] = results[k];
+                m_published[lotId] = {eqpId, startTime, endTime};
             }
         }
+        m_duplicateLots.clear();
+        m_releaseVersion = version;
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Dispatch release " << version << ": " << inserted << " inserted, " << updated << " updated, "
+                  << deleted << " deleted, " << total - inserted - updated << " unchanged in " << elapsed.count()
+                  << " ms" << std::endl;
+        return true;
     }
     catch (const std::exception &e) {
-        std::cerr << "Batch insert failed: " << e.what() << std::endl;
-        success = false;
+        // 回滚后数据库中的计划不确定是否与内存一致，下次写入前重新读取
+        m_hasPublished = false;
+        std::cerr << "Dispatch diff write failed, release rolled back: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool ScheduleDataManagerImpl::hasDispatchDiffQueries() const
+{
+    for (const char *id: {"insertDispatch", "updateDispatch", "deleteDispatch", "getPublishedDispatch", "getDispatchReleaseVersion", "insertDispatchRelease"}) {
+        if (m_queries.find(id) == m_queries.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ScheduleDataManagerImpl::loadPublishedDispatch(PooledSession &sql)
+{
+    m_published.clear();
+    m_duplicateLots.clear();
+
+    // 当前计划：LOT_ID, EQP_ID, START_TIME, END_TIME，按写入顺序返回，同一批次的多行以最后一行为准
+    std::vector<std::string> lotIds(kDispatchFetchRows);
+    std::vector<std::string> eqpIds(kDispatchFetchRows);
+    std::vector<double>      startTimes(kDispatchFetchRows);
+    std::vector<double>      endTimes(kDispatchFetchRows);
+
+    const QueryInfo &query = m_queries.at("getPublishedDispatch");
+    statement       &stmt  = sql.bind(query.id, query.sql, into(lotIds), into(eqpIds), into(startTimes), into(endTimes));
+    stmt.execute();
+    while (stmt.fetch()) {
+        for (size_t k = 0; k < lotIds.size(); ++k) {
+            auto [it, inserted] = m_published.insert_or_assign(lotIds[k], PublishedDispatch {eqpIds[k], startTimes[k], endTimes[k]});
+            if (!inserted) {
+                m_duplicateLots.insert(lotIds[k]);
+            }
+        }
+
+        lotIds.resize(kDispatchFetchRows);
+        eqpIds.resize(kDispatchFetchRows);
+        startTimes.resize(kDispatchFetchRows);
+        endTimes.resize(kDispatchFetchRows);
     }
 
-    return success;
+    // 以前全量追加写入留下的同一批次多行，下次写入时仍在计划中的删除后重新插入一行，不在计划中的整体删除
+    if (!m_duplicateLots.empty()) {
+        std::cerr << "dispatch table has " << m_duplicateLots.size() << " lots with duplicate rows from full-plan writes" << std::endl;
+    }
+
+    const QueryInfo &versionQuery = m_queries.at("getDispatchReleaseVersion");
+    long long        version      = 0;
+    indicator        ind          = i_ok;
+    bool             found        = sql.bind(versionQuery.id, versionQuery.sql, into(version, ind)).execute(true);
+
+    m_releaseVersion = !found || ind == i_null ? 0 : version;
+    m_hasPublished   = true;
+    std::cout << "Loaded " << m_published.size() << " published dispatch rows, release " << m_releaseVersion << std::endl;
+}
+
+void ScheduleDataManagerImpl::setDispatchBatchSize(size_t batchSize)
+{
+    m_dispatchBatchSize = std::max<size_t>(batchSize, 1);
 }
 
 std::unique_ptr<ScheduleDataManager> ScheduleDataManager::create()
@@ -1,4 +1,5 @@
 #include "schedule_evaluator.h"
+#include "schedule_probe.h"
 #include <algorithm>
 #include <numeric>
 
@@ -14,6 +15,8 @@ ScheduleEvaluator::ScheduleEvaluator(
 
 double ScheduleEvaluator::evaluate(const Chromosome &chromosome) const
 {
+    RTD_PROBE_SCOPE("evaluator.evaluate");
+
     // 将染色体解码为机台作业序列
     std::vector<std::vector<size_t>> machineJobs = decode(chromosome);
 
@@ -24,12 +27,31 @@ double ScheduleEvaluator::evaluate(const Chromosome &chromosome) const
     return -makespan;
 }
 
+double ScheduleEvaluator::evaluate(const TwoPartChromosome &chromosome) const
+{
+    RTD_PROBE_SCOPE("evaluator.evaluate");
+
+    const auto         &assignment = chromosome.getAssignment();
+    std::vector<double> machineEndTimes(m_machineCount, 0.0);
+
+    for (size_t lot = 0; lot < assignment.size() && lot < m_lotCount; ++lot) {
+        size_t machine = assignment[lot];
+        if (machine < m_machineCount && m_processingTimes[lot][machine] > 0) {
+            machineEndTimes[machine] += m_processingTimes[lot][machine];
+        }
+    }
+
+    return -*std::max_element(machineEndTimes.begin(), machineEndTimes.end());
+}
+
 double ScheduleEvaluator::evaluateAndUpdate(
   const Chromosome               &chromosome,
   Schedule                       &schedule,
   const std::vector<std::string> &lotIds,
   const std::vector<std::string> &machineIds) const
 {
+    RTD_PROBE_SCOPE("evaluator.evaluate_and_update");
+
     // 清空原有调度
     schedule.clear();
 
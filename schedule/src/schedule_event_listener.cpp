@@ -0,0 +1,235 @@
+#include "schedule_event_listener.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using json = nlohmann::json;
+
+namespace rtd {
+namespace schedule {
+
+namespace {
+
+// 单行事件的最大长度，防止异常客户端占满内存
+constexpr size_t MAX_LINE_LENGTH = 64 * 1024;
+
+}    // namespace
+
+ScheduleEventListener::ScheduleEventListener(const std::string &socketPath, std::chrono::milliseconds debounce)
+    : m_socketPath(socketPath), m_debounce(debounce), m_listenFd(-1), m_running(false)
+{}
+
+ScheduleEventListener::~ScheduleEventListener()
+{
+    stop();
+}
+
+bool ScheduleEventListener::start()
+{
+    sockaddr_un addr {};
+    if (m_socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Event socket path too long: " << m_socketPath << std::endl;
+        return false;
+    }
+
+    m_listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_listenFd < 0) {
+        std::cerr << "Failed to create event socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, m_socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    // 清理上次运行残留的套接字文件
+    ::unlink(m_socketPath.c_str());
+
+    if (::bind(m_listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || ::listen(m_listenFd, 16) != 0) {
+        std::cerr << "Failed to listen on event socket " << m_socketPath << ": " << std::strerror(errno) << std::endl;
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+
+    m_running = true;
+    m_thread  = std::thread(&ScheduleEventListener::run, this);
+    return true;
+}
+
+void ScheduleEventListener::stop()
+{
+    if (!m_running.exchange(false)) {
+        return;
+    }
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    ::close(m_listenFd);
+    m_listenFd = -1;
+    ::unlink(m_socketPath.c_str());
+    m_cv.notify_all();
+}
+
+std::vector<ScheduleEvent> ScheduleEventListener::waitForEvents(
+  std::chrono::steady_clock::time_point deadline,
+  const std::atomic<bool>              &running)
+{
+    std::vector<ScheduleEvent>   events;
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // 分段等待，以便及时响应退出信号
+    while (m_events.empty() && running && std::chrono::steady_clock::now() < deadline) {
+        auto slice = std::min(deadline, std::chrono::steady_clock::now() + std::chrono::seconds(1));
+        m_cv.wait_until(lock, slice);
+    }
+
+    if (m_events.empty() || !running) {
+        return events;
+    }
+
+    // 合并突发事件，避免一次批量上报触发多轮重调度
+    m_cv.wait_for(lock, m_debounce, [this, &running]() { return !running; });
+
+    events.assign(std::make_move_iterator(m_events.begin()), std::make_move_iterator(m_events.end()));
+    m_events.clear();
+    return events;
+}
+
+ScheduleEvent ScheduleEventListener::parseEvent(const std::string &line)
+{
+    json message = json::parse(line);
+
+    ScheduleEvent event;
+    std::string   type = message.at("type").get<std::string>();
+
+    if (type == "lot_arrived") {
+        event.type  = ScheduleEventType::LOT_ARRIVED;
+        event.lotId = message.at("lot_id").get<std::string>();
+        if (message.contains("process_times")) {
+            for (auto &[eqpId, time]: message["process_times"].items()) {
+                event.processTimes[eqpId] = time.get<double>();
+            }
+        }
+    }
+    else if (type == "lot_finished") {
+        event.type  = ScheduleEventType::LOT_FINISHED;
+        event.lotId = message.at("lot_id").get<std::string>();
+    }
+    else if (type == "equipment_down") {
+        event.type        = ScheduleEventType::EQUIPMENT_DOWN;
+        event.equipmentId = message.at("eqp_id").get<std::string>();
+    }
+    else if (type == "equipment_up") {
+        event.type        = ScheduleEventType::EQUIPMENT_UP;
+        event.equipmentId = message.at("eqp_id").get<std::string>();
+    }
+    else if (type == "process_time_changed") {
+        event.type        = ScheduleEventType::PROCESS_TIME_CHANGED;
+        event.lotId       = message.at("lot_id").get<std::string>();
+        event.equipmentId = message.at("eqp_id").get<std::string>();
+        event.processTime = message.at("process_time").get<double>();
+    }
+    else {
+        throw std::invalid_argument("Unknown event type: " + type);
+    }
+
+    return event;
+}
+
+std::string ScheduleEventListener::handleLine(const std::string &line)
+{
+    try {
+        ScheduleEvent event = parseEvent(line);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_events.push_back(std::move(event));
+        }
+        m_cv.notify_all();
+        return "{\"status\":\"ok\"}\n";
+    }
+    catch (const std::exception &e) {
+        json reply = {
+          {"error", e.what()}
+        };
+        return reply.dump() + "\n";
+    }
+}
+
+void ScheduleEventListener::run()
+{
+    struct Client {
+            int         fd;
+            std::string buffer;
+    };
+
+    std::vector<Client> clients;
+
+    while (m_running) {
+        std::vector<pollfd> fds;
+        fds.push_back({m_listenFd, POLLIN, 0});
+        for (const auto &client: clients) {
+            fds.push_back({client.fd, POLLIN, 0});
+        }
+
+        // 超时返回以便检查停止标志
+        int ready = ::poll(fds.data(), fds.size(), 500);
+        if (ready <= 0) {
+            continue;
+        }
+
+        // 读取已连接客户端的数据
+        for (size_t i = fds.size() - 1; i >= 1; --i) {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                continue;
+            }
+
+            Client &client = clients[i - 1];
+            char    buffer[4096];
+            ssize_t n      = ::read(client.fd, buffer, sizeof(buffer));
+
+            if (n > 0) {
+                client.buffer.append(buffer, n);
+
+                size_t pos;
+                while ((pos = client.buffer.find('\n')) != std::string::npos) {
+                    std::string line = client.buffer.substr(0, pos);
+                    client.buffer.erase(0, pos + 1);
+                    if (line.empty()) {
+                        continue;
+                    }
+
+                    std::string reply = handleLine(line);
+                    ::send(client.fd, reply.data(), reply.size(), MSG_NOSIGNAL);
+                }
+            }
+
+            if (n <= 0 || client.buffer.size() > MAX_LINE_LENGTH) {
+                ::close(client.fd);
+                clients.erase(clients.begin() + (i - 1));
+            }
+        }
+
+        // 接受新连接
+        if (fds[0].revents & POLLIN) {
+            int fd = ::accept(m_listenFd, nullptr, nullptr);
+            if (fd >= 0) {
+                clients.push_back({fd, ""});
+            }
+        }
+    }
+
+    for (const auto &client: clients) {
+        ::close(client.fd);
+    }
+}
+
+}    // namespace schedule
+}    // namespace rtd
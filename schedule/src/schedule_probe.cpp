@@ -0,0 +1,206 @@
+#include "schedule_probe.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace rtd {
+namespace schedule {
+namespace probe {
+
+namespace {
+
+// 每个线程最多保留的计时事件数，超出后只累计统计
+constexpr size_t kMaxEventsPerThread = 1 << 20;
+
+struct ProbeEvent {
+        const char *name;
+        int64_t     startNs;
+        int64_t     durationNs;
+};
+
+struct ThreadBuffer;
+
+// 全局记录：存活线程的缓冲区和已退出线程的数据
+struct Registry {
+        std::mutex                                   mutex;
+        std::vector<ThreadBuffer *>                  liveBuffers;
+        std::vector<std::pair<uint32_t, ProbeEvent>> retiredEvents;
+        std::map<std::string, ProbeStats>            retiredStats;
+        uint32_t                                     nextThreadId = 1;
+};
+
+Registry &registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+void mergeStats(std::map<std::string, ProbeStats> &target, const std::unordered_map<const char *, ProbeStats> &source)
+{
+    for (const auto &[name, stats]: source) {
+        auto &merged = target[name];
+        merged.calls += stats.calls;
+        merged.totalNs += stats.totalNs;
+        merged.maxNs = std::max(merged.maxNs, stats.maxNs);
+        merged.counter += stats.counter;
+    }
+}
+
+struct ThreadBuffer {
+        uint32_t                                     threadId;
+        std::vector<ProbeEvent>                      events;
+        std::unordered_map<const char *, ProbeStats> stats;
+
+        ThreadBuffer()
+        {
+            auto                       &reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            threadId = reg.nextThreadId++;
+            reg.liveBuffers.push_back(this);
+        }
+
+        ~ThreadBuffer()
+        {
+            auto                       &reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            for (const auto &event: events) {
+                reg.retiredEvents.push_back({threadId, event});
+            }
+            mergeStats(reg.retiredStats, stats);
+            reg.liveBuffers.erase(std::remove(reg.liveBuffers.begin(), reg.liveBuffers.end(), this), reg.liveBuffers.end());
+        }
+};
+
+ThreadBuffer &threadBuffer()
+{
+    thread_local ThreadBuffer buffer;
+    return buffer;
+}
+
+}    // namespace
+
+int64_t nowNs()
+{
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void record(const char *name, int64_t startNs, int64_t durationNs)
+{
+    ThreadBuffer &buffer = threadBuffer();
+    if (buffer.events.size() < kMaxEventsPerThread) {
+        buffer.events.push_back({name, startNs, durationNs});
+    }
+
+    auto &stats = buffer.stats[name];
+    ++stats.calls;
+    stats.totalNs += static_cast<uint64_t>(durationNs);
+    stats.maxNs = std::max(stats.maxNs, static_cast<uint64_t>(durationNs));
+}
+
+void count(const char *name, uint64_t delta)
+{
+    threadBuffer().stats[name].counter += delta;
+}
+
+std::map<std::string, ProbeStats> collect()
+{
+    auto                       &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    std::map<std::string, ProbeStats> result = reg.retiredStats;
+    for (const ThreadBuffer *buffer: reg.liveBuffers) {
+        mergeStats(result, buffer->stats);
+    }
+    return result;
+}
+
+void printSummary(std::ostream &out)
+{
+    auto stats = collect();
+    if (stats.empty()) {
+        return;
+    }
+
+    out << std::left << std::setw(36) << "probe" << std::right << std::setw(12) << "calls"
+        << std::setw(14) << "total_ms" << std::setw(12) << "avg_us" << std::setw(12) << "max_us"
+        << std::setw(14) << "counter" << '\n';
+
+    for (const auto &[name, probe]: stats) {
+        double avgUs = probe.calls > 0 ? probe.totalNs / 1e3 / probe.calls : 0.0;
+        out << std::left << std::setw(36) << name << std::right << std::setw(12) << probe.calls
+            << std::setw(14) << std::fixed << std::setprecision(3) << probe.totalNs / 1e6
+            << std::setw(12) << avgUs << std::setw(12) << probe.maxNs / 1e3
+            << std::setw(14) << probe.counter << '\n';
+    }
+    out.unsetf(std::ios::floatfield);
+}
+
+bool exportChromeTrace(const std::string &path)
+{
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "无法写入trace文件: " << path << std::endl;
+        return false;
+    }
+
+    auto                       &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    bool    first      = true;
+    int64_t lastNs     = 0;
+    auto    writeEvent = [&](uint32_t threadId, const ProbeEvent &event) {
+        file << (first ? "\n" : ",\n") << "{\"name\":\"" << event.name << "\",\"cat\":\"rtd\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId
+             << ",\"ts\":" << event.startNs / 1e3 << ",\"dur\":" << event.durationNs / 1e3 << '}';
+        first  = false;
+        lastNs = std::max(lastNs, event.startNs + event.durationNs);
+    };
+
+    file << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (const auto &[threadId, event]: reg.retiredEvents) {
+        writeEvent(threadId, event);
+    }
+    for (const ThreadBuffer *buffer: reg.liveBuffers) {
+        for (const auto &event: buffer->events) {
+            writeEvent(buffer->threadId, event);
+        }
+    }
+
+    // 计数探针以counter事件输出在trace末尾
+    std::map<std::string, ProbeStats> stats = reg.retiredStats;
+    for (const ThreadBuffer *buffer: reg.liveBuffers) {
+        mergeStats(stats, buffer->stats);
+    }
+    for (const auto &[name, probe]: stats) {
+        if (probe.counter == 0) {
+            continue;
+        }
+        file << (first ? "\n" : ",\n") << "{\"name\":\"" << name << "\",\"cat\":\"rtd\",\"ph\":\"C\",\"pid\":1,\"ts\":" << lastNs / 1e3
+             << ",\"args\":{\"value\":" << probe.counter << "}}";
+        first = false;
+    }
+
+    file << "\n]}\n";
+    return file.good();
+}
+
+void reset()
+{
+    auto                       &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    reg.retiredEvents.clear();
+    reg.retiredStats.clear();
+    for (ThreadBuffer *buffer: reg.liveBuffers) {
+        buffer->events.clear();
+        buffer->stats.clear();
+    }
+}
+
+}    // namespace probe
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,137 @@
+#include "schedule_problem.h"
+
+namespace rtd {
+namespace schedule {
+
+void ScheduleProblem::reset(
+  const std::vector<std::string>         &lotIds,
+  const std::vector<std::string>         &machineIds,
+  const std::vector<std::vector<double>> &processingTimes)
+{
+    m_lotIds          = lotIds;
+    m_machineIds      = machineIds;
+    m_processingTimes = processingTimes;
+    m_machineDown.assign(machineIds.size(), false);
+
+    m_lotIndex.clear();
+    for (size_t i = 0; i < m_lotIds.size(); ++i) {
+        m_lotIndex[m_lotIds[i]] = i;
+    }
+
+    m_machineIndex.clear();
+    for (size_t j = 0; j < m_machineIds.size(); ++j) {
+        m_machineIndex[m_machineIds[j]] = j;
+    }
+}
+
+bool ScheduleProblem::apply(const ScheduleEvent &event)
+{
+    switch (event.type) {
+        case ScheduleEventType::LOT_ARRIVED:
+            return addLot(event.lotId, event.processTimes);
+        case ScheduleEventType::LOT_FINISHED:
+            return removeLot(event.lotId);
+        case ScheduleEventType::EQUIPMENT_DOWN:
+            return setMachineDown(event.equipmentId, true);
+        case ScheduleEventType::EQUIPMENT_UP:
+            return setMachineDown(event.equipmentId, false);
+        case ScheduleEventType::PROCESS_TIME_CHANGED:
+            return setProcessTime(event.lotId, event.equipmentId, event.processTime);
+    }
+
+    return false;
+}
+
+void ScheduleProblem::exportSchedulable(
+  std::vector<std::string>         &lotIds,
+  std::vector<std::vector<double>> &processingTimes) const
+{
+    lotIds.clear();
+    processingTimes.clear();
+
+    for (size_t i = 0; i < m_lotIds.size(); ++i) {
+        std::vector<double> row(m_machineIds.size(), 0.0);
+        bool                hasValidMachine = false;
+
+        for (size_t j = 0; j < m_machineIds.size(); ++j) {
+            if (!m_machineDown[j] && m_processingTimes[i][j] > 0) {
+                row[j]          = m_processingTimes[i][j];
+                hasValidMachine = true;
+            }
+        }
+
+        // 所有可用机台都停机的批次暂不调度，设备恢复后重新加入
+        if (hasValidMachine) {
+            lotIds.push_back(m_lotIds[i]);
+            processingTimes.push_back(std::move(row));
+        }
+    }
+}
+
+bool ScheduleProblem::addLot(const std::string &lotId, const std::map<std::string, double> &processTimes)
+{
+    if (m_lotIndex.count(lotId)) {
+        return false;
+    }
+
+    std::vector<double> row(m_machineIds.size(), 0.0);
+    for (const auto &[eqpId, time]: processTimes) {
+        auto it = m_machineIndex.find(eqpId);
+        if (it != m_machineIndex.end()) {
+            row[it->second] = time;
+        }
+    }
+
+    m_lotIndex[lotId] = m_lotIds.size();
+    m_lotIds.push_back(lotId);
+    m_processingTimes.push_back(std::move(row));
+    return true;
+}
+
+bool ScheduleProblem::removeLot(const std::string &lotId)
+{
+    auto it = m_lotIndex.find(lotId);
+    if (it == m_lotIndex.end()) {
+        return false;
+    }
+
+    // 与最后一个批次交换后删除，保持O(1)
+    size_t index = it->second;
+    size_t last  = m_lotIds.size() - 1;
+    if (index != last) {
+        m_lotIds[index]             = std::move(m_lotIds[last]);
+        m_processingTimes[index]    = std::move(m_processingTimes[last]);
+        m_lotIndex[m_lotIds[index]] = index;
+    }
+
+    m_lotIds.pop_back();
+    m_processingTimes.pop_back();
+    m_lotIndex.erase(lotId);
+    return true;
+}
+
+bool ScheduleProblem::setMachineDown(const std::string &equipmentId, bool down)
+{
+    auto it = m_machineIndex.find(equipmentId);
+    if (it == m_machineIndex.end() || m_machineDown[it->second] == down) {
+        return false;
+    }
+
+    m_machineDown[it->second] = down;
+    return true;
+}
+
+bool ScheduleProblem::setProcessTime(const std::string &lotId, const std::string &equipmentId, double time)
+{
+    auto lotIt     = m_lotIndex.find(lotId);
+    auto machineIt = m_machineIndex.find(equipmentId);
+    if (lotIt == m_lotIndex.end() || machineIt == m_machineIndex.end()) {
+        return false;
+    }
+
+    m_processingTimes[lotIt->second][machineIt->second] = time;
+    return true;
+}
+
+}    // namespace schedule
+}    // namespace rtd
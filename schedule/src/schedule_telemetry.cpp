@@ -0,0 +1,54 @@
+#include "schedule_telemetry.h"
+#include <chrono>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace rtd {
+namespace schedule {
+
+TelemetryJsonLinesWriter::TelemetryJsonLinesWriter(const std::string &path)
+    : m_file(path, std::ios::app), m_run(0)
+{}
+
+void TelemetryJsonLinesWriter::write(const GenerationStats &stats)
+{
+    json islands = json::array();
+    for (const auto &island: stats.islands) {
+        islands.push_back({
+          {"best", island.bestFitness},
+          {"mean", island.meanFitness},
+          {"worst", island.worstFitness},
+          {"diversity", island.diversity}});
+    }
+
+    json line = {
+      {"timestamp", std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::system_clock::now().time_since_epoch())
+                      .count()},
+      {"generation", stats.generation},
+      {"elapsed_s", stats.elapsedSeconds},
+      {"evaluations", stats.evaluations},
+      {"evals_per_s", stats.evaluationsPerSecond},
+      {"best_makespan", stats.bestMakespan},
+      {"islands", islands},
+      {"phases_s", {{"selection", stats.phases.selection}, {"crossover", stats.phases.crossover}, {"mutation", stats.phases.mutation}, {"repair", stats.phases.repair}, {"evaluation", stats.phases.evaluation}, {"migration", stats.phases.migration}}}};
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (stats.generation == 0) {
+        ++m_run;
+    }
+    line["run"] = m_run;
+    m_file << line.dump() << '\n';
+    m_file.flush();
+}
+
+TelemetryCallback TelemetryJsonLinesWriter::callback()
+{
+    return [this](const GenerationStats &stats) {
+        write(stats);
+    };
+}
+
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,242 @@
+#include "schedule_two_part_chromosome.h"
+#include "schedule_probe.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace rtd {
+namespace schedule {
+
+namespace {
+
+// 在可加工机台中随机选取
+size_t randomMachine(const std::vector<size_t> &machines, std::mt19937 &generator)
+{
+    std::uniform_int_distribution<size_t> dist(0, machines.size() - 1);
+    return machines[dist(generator)];
+}
+
+}    // namespace
+
+TwoPartChromosome TwoPartChromosome::createRandom(const EligibilityTable &eligibility, std::mt19937 &generator)
+{
+    RTD_PROBE_SCOPE("two_part.create_random");
+
+    const size_t lotCount     = eligibility.lotCount();
+    const size_t machineCount = eligibility.machineCount();
+
+    std::vector<size_t> assignment(lotCount, machineCount);
+    std::vector<size_t> sequence;
+    sequence.reserve(lotCount);
+
+    for (size_t lot = 0; lot < lotCount; ++lot) {
+        const auto &machines = eligibility.machines(lot);
+        if (!machines.empty()) {
+            assignment[lot] = randomMachine(machines, generator);
+            sequence.push_back(lot);
+        }
+    }
+
+    std::shuffle(sequence.begin(), sequence.end(), generator);
+
+    return TwoPartChromosome(std::move(assignment), std::move(sequence));
+}
+
+TwoPartChromosome TwoPartChromosome::fromChromosome(
+  const Chromosome       &chromosome,
+  const EligibilityTable &eligibility,
+  std::mt19937           &generator)
+{
+    const size_t lotCount     = eligibility.lotCount();
+    const size_t machineCount = eligibility.machineCount();
+
+    std::vector<size_t> assignment(lotCount, machineCount);
+    std::vector<size_t> sequence;
+    sequence.reserve(chromosome.getLength());
+
+    // 重复的批次保留第一次出现的分配，其余交给修复
+    for (size_t gene: chromosome.getGenes()) {
+        size_t lot = gene / machineCount;
+        if (lot < lotCount && assignment[lot] == machineCount) {
+            assignment[lot] = gene % machineCount;
+            sequence.push_back(lot);
+        }
+    }
+
+    TwoPartChromosome result(std::move(assignment), std::move(sequence));
+    result.repair(eligibility, generator);
+    return result;
+}
+
+Chromosome TwoPartChromosome::toChromosome(size_t machineCount) const
+{
+    std::vector<size_t> genes;
+    genes.reserve(m_sequence.size());
+    for (size_t lot: m_sequence) {
+        genes.push_back(lot * machineCount + m_assignment[lot]);
+    }
+    return Chromosome(genes);
+}
+
+TwoPartChromosome TwoPartChromosome::crossover(const TwoPartChromosome &other, std::mt19937 &generator) const
+{
+    RTD_PROBE_SCOPE("two_part.crossover");
+
+    const size_t lotCount = m_assignment.size();
+    const size_t length   = m_sequence.size();
+    if (other.m_assignment.size() != lotCount || other.m_sequence.size() != length) {
+        return *this;
+    }
+
+    // 机台分配段均匀交叉，每个随机数提供32个批次的取舍
+    std::vector<size_t> assignment(m_assignment);
+    for (size_t lot = 0; lot < lotCount; lot += 32) {
+        uint32_t bits = static_cast<uint32_t>(generator());
+        for (size_t i = lot; i < lot + 32 && i < lotCount; ++i, bits >>= 1) {
+            if (bits & 1u) {
+                assignment[i] = other.m_assignment[i];
+            }
+        }
+    }
+
+    if (length <= 2) {
+        return TwoPartChromosome(std::move(assignment), m_sequence);
+    }
+
+    // 加工顺序段顺序交叉(OX)
+    std::uniform_int_distribution<size_t> dist(0, length - 1);
+    size_t                                start = dist(generator);
+    size_t                                end   = dist(generator);
+    if (start > end) {
+        std::swap(start, end);
+    }
+
+    std::vector<size_t> sequence(length, 0);
+    std::vector<bool>   lotUsed(lotCount, false);
+    for (size_t i = start; i <= end; ++i) {
+        sequence[i]            = m_sequence[i];
+        lotUsed[m_sequence[i]] = true;
+    }
+
+    size_t j      = (end + 1) % length;
+    size_t filled = end - start + 1;
+    for (size_t i = 0; i < length && filled < length; ++i) {
+        size_t lot = other.m_sequence[(end + 1 + i) % length];
+        if (!lotUsed[lot]) {
+            sequence[j]  = lot;
+            lotUsed[lot] = true;
+            j            = (j + 1) % length;
+            ++filled;
+        }
+    }
+
+    // 两个父代的批次集合不同（未经修复的个体）时沿用本父代的顺序
+    if (filled < length) {
+        sequence = m_sequence;
+    }
+
+    return TwoPartChromosome(std::move(assignment), std::move(sequence));
+}
+
+void TwoPartChromosome::mutate(
+  double                  assignmentRate,
+  double                  sequenceRate,
+  const EligibilityTable &eligibility,
+  std::mt19937           &generator)
+{
+    RTD_PROBE_SCOPE("two_part.mutate");
+
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    // 机台重分配：在除当前机台外的可加工机台中均匀选取
+    for (size_t lot = 0; lot < m_assignment.size(); ++lot) {
+        if (dist(generator) >= assignmentRate) {
+            continue;
+        }
+
+        const auto &machines = eligibility.machines(lot);
+        if (machines.size() <= 1) {
+            continue;
+        }
+
+        std::uniform_int_distribution<size_t> machineDist(0, machines.size() - 2);
+        size_t                                machine = machines[machineDist(generator)];
+        m_assignment[lot]                             = machine == m_assignment[lot] ? machines.back() : machine;
+    }
+
+    // 加工顺序交换
+    if (m_sequence.size() <= 1) {
+        return;
+    }
+
+    std::uniform_int_distribution<size_t> posDist(0, m_sequence.size() - 1);
+    for (size_t i = 0; i < m_sequence.size() - 1; ++i) {
+        if (dist(generator) < sequenceRate) {
+            std::swap(m_sequence[i], m_sequence[posDist(generator)]);
+        }
+    }
+}
+
+bool TwoPartChromosome::isValid(const EligibilityTable &eligibility) const
+{
+    const size_t lotCount = eligibility.lotCount();
+    if (m_assignment.size() != lotCount) {
+        return false;
+    }
+
+    std::vector<bool> lotUsed(lotCount, false);
+    for (size_t lot: m_sequence) {
+        if (lot >= lotCount || lotUsed[lot] || m_assignment[lot] >= eligibility.machineCount() || !eligibility.isEligible(lot, m_assignment[lot])) {
+            return false;
+        }
+        lotUsed[lot] = true;
+    }
+
+    return true;
+}
+
+void TwoPartChromosome::repair(const EligibilityTable &eligibility, std::mt19937 &generator)
+{
+    RTD_PROBE_SCOPE("two_part.repair");
+
+    const size_t lotCount     = eligibility.lotCount();
+    const size_t machineCount = eligibility.machineCount();
+
+    m_assignment.resize(lotCount, machineCount);
+
+    // 剔除越界和重复的批次，修正无效分配
+    std::vector<bool> lotUsed(lotCount, false);
+    size_t            write = 0;
+    for (size_t lot: m_sequence) {
+        if (lot >= lotCount || lotUsed[lot] || eligibility.machines(lot).empty()) {
+            continue;
+        }
+
+        lotUsed[lot] = true;
+        if (m_assignment[lot] >= machineCount || !eligibility.isEligible(lot, m_assignment[lot])) {
+            m_assignment[lot] = randomMachine(eligibility.machines(lot), generator);
+        }
+        m_sequence[write++] = lot;
+    }
+    m_sequence.resize(write);
+
+    // 补入缺失的批次
+    for (size_t lot = 0; lot < lotCount; ++lot) {
+        if (lotUsed[lot]) {
+            continue;
+        }
+
+        const auto &machines = eligibility.machines(lot);
+        if (machines.empty()) {
+            m_assignment[lot] = machineCount;
+            continue;
+        }
+
+        if (m_assignment[lot] >= machineCount || !eligibility.isEligible(lot, m_assignment[lot])) {
+            m_assignment[lot] = randomMachine(machines, generator);
+        }
+        m_sequence.push_back(lot);
+    }
+}
+
+}    // namespace schedule
+}    // namespace rtd
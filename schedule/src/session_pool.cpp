@@ -0,0 +1,151 @@
+#include "session_pool.h"
+#include <algorithm>
+#include <iostream>
+#include <soci/sqlite3/soci-sqlite3.h>
+
+namespace rtd {
+namespace schedule {
+
+PooledSession::PooledSession(const soci::backend_factory &backend, const std::string &connectionString)
+    : soci::session(backend, connectionString)
+{}
+
+PooledSession::~PooledSession()
+{
+    // 语句须在所属连接关闭前释放
+    m_statements.clear();
+}
+
+soci::statement &PooledSession::prepared(const std::string &id, const std::string &sql)
+{
+    auto &stmt = m_statements[id];
+    if (!stmt) {
+        auto fresh = std::make_unique<soci::statement>(*this);
+        fresh->alloc();
+        fresh->prepare(sql);
+        stmt = std::move(fresh);
+    }
+    else {
+        // 解除上次执行的绑定（上次可能因异常没有执行完）
+        stmt->bind_clean_up();
+    }
+    return *stmt;
+}
+
+bool PooledSession::ensureConnected()
+{
+    if (is_connected()) {
+        return true;
+    }
+
+    // 旧连接上准备的语句不能再用，先于重连释放
+    m_statements.clear();
+    try {
+        reconnect();
+        return true;
+    }
+    catch (const std::exception &e) {
+        std::cerr << "Failed to reconnect pooled session: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void PooledSession::finishStatements()
+{
+    // 复位后下次execute照常执行，其他后端没有需要结束的状态
+    for (auto &[id, stmt]: m_statements) {
+        if (auto *backend = dynamic_cast<soci::sqlite3_statement_backend *>(stmt->get_backend())) {
+            sqlite3_reset(backend->stmt_);
+        }
+    }
+}
+
+SessionPool::SessionPool(
+  const soci::backend_factory &backend,
+  std::string                  connectionString,
+  size_t                       minConn,
+  size_t                       maxConn,
+  std::chrono::seconds         timeout)
+    : m_backend(backend), m_connectionString(std::move(connectionString)), m_minConn(minConn), m_maxConn(std::max<size_t>(maxConn, 1)), m_timeout(timeout)
+{
+    m_minConn = std::min(m_minConn, m_maxConn);
+}
+
+bool SessionPool::open()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    while (m_total < m_minConn) {
+        try {
+            m_idle.push_back(std::make_unique<PooledSession>(m_backend, m_connectionString));
+            ++m_total;
+        }
+        catch (const std::exception &e) {
+            std::cerr << "Failed to open pooled session: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::shared_ptr<PooledSession> SessionPool::acquire()
+{
+    std::unique_ptr<PooledSession> session;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // 没有空闲会话且已达上限时等待归还
+        bool ready = m_available.wait_for(lock, m_timeout, [this]() { return !m_idle.empty() || m_total < m_maxConn; });
+        if (!ready) {
+            std::cerr << "Timed out waiting for a database session (" << m_maxConn << " in use)" << std::endl;
+            return nullptr;
+        }
+
+        if (!m_idle.empty()) {
+            session = std::move(m_idle.back());
+            m_idle.pop_back();
+        }
+        else {
+            // 先占住名额，在锁外建立连接
+            ++m_total;
+        }
+    }
+
+    // 空闲期间断开的会话重新连接，重连失败则丢弃并新建
+    if (session && !session->ensureConnected()) {
+        session.reset();
+    }
+
+    if (!session) {
+        try {
+            session = std::make_unique<PooledSession>(m_backend, m_connectionString);
+        }
+        catch (const std::exception &e) {
+            std::cerr << "Failed to open pooled session: " << e.what() << std::endl;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_total;
+            m_available.notify_one();
+            return nullptr;
+        }
+    }
+
+    auto pool = shared_from_this();
+    return std::shared_ptr<PooledSession>(session.release(), [pool](PooledSession *returned) {
+        pool->release(returned);
+    });
+}
+
+void SessionPool::release(PooledSession *session)
+{
+    session->finishStatements();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_idle.emplace_back(session);
+    }
+    m_available.notify_one();
+}
+
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,295 @@
+#include "problem_snapshot.h"
+#include "schedule_data_manager.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+namespace rtd {
+namespace schedule {
+
+/**
+ * 从问题快照文件读取主数据的数据管理器，用于离线回放和性能测试
+ * 调度结果写入快照旁的CSV文件（<快照路径>.dispatch.csv）
+ * 流水线模式下refreshSnapshot在预取线程上重新读取文件，同时主线程在增量调度中查询处理时间，
+ * 因此快照和索引整体放在不可变的LoadedData中，加载完成后在锁内替换，查询先在锁内取得当前数据的引用
+ */
+class SnapshotDataManager: public ScheduleDataManager {
+    public:
+        explicit SnapshotDataManager(std::string snapshotPath);
+
+        bool                             initialize(const std::string &configPath) override;
+        std::vector<std::string>         getAllEquipments() override;
+        std::vector<std::string>         getLotsByEquipment(const std::string &equipmentId) override;
+        std::vector<std::string>         getAllLots() override;
+        LotEligibility                   getLotEligibility(const std::vector<std::string> &equipments) override;
+        double                           getProcessTime(const std::string &equipmentId, const std::string &lotId) override;
+        std::map<std::string, double>    getProcessTimesByLot(
+          const std::string              &lotId,
+          const std::vector<std::string> &equipments) override;
+        std::vector<std::vector<double>> getProcessTimeMatrix(
+          const std::vector<std::string> &lots,
+          const std::vector<std::string> &equipments) override;
+        std::vector<std::vector<double>> getProcessTimeMatrix(
+          const LotEligibility           &eligibility,
+          const std::vector<std::string> &equipments) override;
+        const MasterDataSnapshot        &refreshSnapshot(bool fullReload) override;
+        bool saveDispatchResult(
+          const std::string &equipmentId,
+          const std::string &lotId,
+          double             releaseTime,
+          double             startTime,
+          double             endTime) override;
+        bool saveDispatchResults(
+          const std::vector<std::tuple<std::string, std::string, double, double, double>> &results) override;
+        bool saveDispatchDiff(
+          const std::vector<std::tuple<std::string, std::string, double, double, double>> &results,
+          double                                                                           releaseTime) override;
+        void setDispatchBatchSize(size_t batchSize) override;
+
+    private:
+        struct LoadedData {
+                MasterDataSnapshot                      snapshot;
+                std::unordered_map<std::string, size_t> lotIndexMap;
+                std::unordered_map<std::string, size_t> equipmentIndexMap;
+        };
+
+        std::string                       m_path;
+        std::string                       m_dispatchPath;
+        std::mutex                        m_dataMutex;
+        std::shared_ptr<const LoadedData> m_data;
+
+        // 读取快照文件并建立索引，成功后替换当前数据
+        bool load();
+
+        // 当前数据，未加载时为空快照
+        std::shared_ptr<const LoadedData> data();
+
+        // 按ID查询处理时间
+        static double processTime(const LoadedData &data, const std::string &equipmentId, const std::string &lotId);
+
+        // 写入调度结果，truncate为true时覆盖原文件
+        bool writeDispatch(
+          const std::vector<std::tuple<std::string, std::string, double, double, double>> &results,
+          bool                                                                             truncate);
+};
+
+SnapshotDataManager::SnapshotDataManager(std::string snapshotPath)
+    : m_path(std::move(snapshotPath)), m_dispatchPath(m_path + ".dispatch.csv"), m_data(std::make_shared<LoadedData>())
+{}
+
+bool SnapshotDataManager::initialize(const std::string &configPath)
+{
+    (void)configPath;    // 不需要数据源配置
+    return load();
+}
+
+bool SnapshotDataManager::load()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    auto loaded = std::make_shared<LoadedData>();
+    if (!readProblemSnapshot(m_path, loaded->snapshot)) {
+        std::cerr << "Failed to read problem snapshot: " << m_path << std::endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < loaded->snapshot.lots.size(); ++i) {
+        loaded->lotIndexMap[loaded->snapshot.lots[i]] = i;
+    }
+    for (size_t j = 0; j < loaded->snapshot.equipments.size(); ++j) {
+        loaded->equipmentIndexMap[loaded->snapshot.equipments[j]] = j;
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Loaded problem snapshot " << m_path << ": " << loaded->snapshot.equipments.size() << " equipments, "
+              << loaded->snapshot.lots.size() << " lots in " << elapsed.count() << " ms" << std::endl;
+
+    std::lock_guard<std::mutex> lock(m_dataMutex);
+    m_data = std::move(loaded);
+    return true;
+}
+
+std::shared_ptr<const SnapshotDataManager::LoadedData> SnapshotDataManager::data()
+{
+    std::lock_guard<std::mutex> lock(m_dataMutex);
+    return m_data;
+}
+
+double SnapshotDataManager::processTime(const LoadedData &data, const std::string &equipmentId, const std::string &lotId)
+{
+    auto lotIt = data.lotIndexMap.find(lotId);
+    auto eqpIt = data.equipmentIndexMap.find(equipmentId);
+    if (lotIt == data.lotIndexMap.end() || eqpIt == data.equipmentIndexMap.end()) {
+        return 0.0;
+    }
+    return data.snapshot.processingTimes[lotIt->second][eqpIt->second];
+}
+
+std::vector<std::string> SnapshotDataManager::getAllEquipments()
+{
+    return data()->snapshot.equipments;
+}
+
+std::vector<std::string> SnapshotDataManager::getLotsByEquipment(const std::string &equipmentId)
+{
+    std::vector<std::string> lots;
+    auto                     current  = data();
+    const auto              &snapshot = current->snapshot;
+
+    auto eqpIt = current->equipmentIndexMap.find(equipmentId);
+    if (eqpIt == current->equipmentIndexMap.end()) {
+        return lots;
+    }
+
+    for (size_t i = 0; i < snapshot.lots.size(); ++i) {
+        if (snapshot.processingTimes[i][eqpIt->second] > 0) {
+            lots.push_back(snapshot.lots[i]);
+        }
+    }
+    return lots;
+}
+
+std::vector<std::string> SnapshotDataManager::getAllLots()
+{
+    return data()->snapshot.lots;
+}
+
+LotEligibility SnapshotDataManager::getLotEligibility(const std::vector<std::string> &equipments)
+{
+    // 快照中的批次已按ID排序，可加工设备即处理时间大于0的设备
+    LotEligibility eligibility;
+    auto           current  = data();
+    const auto    &snapshot = current->snapshot;
+    for (size_t i = 0; i < snapshot.lots.size(); ++i) {
+        std::vector<size_t> eqps;
+        for (size_t j = 0; j < equipments.size(); ++j) {
+            auto eqpIt = current->equipmentIndexMap.find(equipments[j]);
+            if (eqpIt != current->equipmentIndexMap.end() && snapshot.processingTimes[i][eqpIt->second] > 0) {
+                eqps.push_back(j);
+            }
+        }
+
+        if (!eqps.empty()) {
+            eligibility.lots.push_back(snapshot.lots[i]);
+            eligibility.equipments.push_back(std::move(eqps));
+        }
+    }
+    return eligibility;
+}
+
+double SnapshotDataManager::getProcessTime(const std::string &equipmentId, const std::string &lotId)
+{
+    return processTime(*data(), equipmentId, lotId);
+}
+
+std::map<std::string, double> SnapshotDataManager::getProcessTimesByLot(
+  const std::string              &lotId,
+  const std::vector<std::string> &equipments)
+{
+    std::map<std::string, double> times;
+    auto                          current = data();
+    for (const auto &eqpId: equipments) {
+        double time = processTime(*current, eqpId, lotId);
+        if (time > 0) {
+            times[eqpId] = time;
+        }
+    }
+    return times;
+}
+
+std::vector<std::vector<double>> SnapshotDataManager::getProcessTimeMatrix(
+  const std::vector<std::string> &lots,
+  const std::vector<std::string> &equipments)
+{
+    std::vector<std::vector<double>> matrix(lots.size(), std::vector<double>(equipments.size(), 0.0));
+    auto                             current = data();
+    for (size_t i = 0; i < lots.size(); ++i) {
+        for (size_t j = 0; j < equipments.size(); ++j) {
+            matrix[i][j] = processTime(*current, equipments[j], lots[i]);
+        }
+    }
+    return matrix;
+}
+
+std::vector<std::vector<double>> SnapshotDataManager::getProcessTimeMatrix(
+  const LotEligibility           &eligibility,
+  const std::vector<std::string> &equipments)
+{
+    return getProcessTimeMatrix(eligibility.lots, equipments);
+}
+
+const MasterDataSnapshot &SnapshotDataManager::refreshSnapshot(bool fullReload)
+{
+    // 快照文件可能已被新的录制替换，全量加载时重新读取；读取失败时保留原有数据。
+    // 数据只在刷新时替换，返回的引用在下一次刷新前有效
+    if (fullReload) {
+        load();
+    }
+    return data()->snapshot;
+}
+
+bool SnapshotDataManager::saveDispatchResult(
+  const std::string &equipmentId,
+  const std::string &lotId,
+  double             releaseTime,
+  double             startTime,
+  double             endTime)
+{
+    return writeDispatch({std::make_tuple(equipmentId, lotId, releaseTime, startTime, endTime)}, false);
+}
+
+bool SnapshotDataManager::saveDispatchResults(
+  const std::vector<std::tuple<std::string, std::string, double, double, double>> &results)
+{
+    return writeDispatch(results, false);
+}
+
+bool SnapshotDataManager::saveDispatchDiff(
+  const std::vector<std::tuple<std::string, std::string, double, double, double>> &results,
+  double                                                                           releaseTime)
+{
+    // 文件只保存当前计划，每次发布整体覆盖
+    std::vector<std::tuple<std::string, std::string, double, double, double>> released;
+    released.reserve(results.size());
+    for (const auto &[eqpId, lotId, release, startTime, endTime]: results) {
+        released.emplace_back(eqpId, lotId, releaseTime, startTime, endTime);
+    }
+    return writeDispatch(released, true);
+}
+
+void SnapshotDataManager::setDispatchBatchSize(size_t batchSize)
+{
+    (void)batchSize;    // 写文件不分批
+}
+
+bool SnapshotDataManager::writeDispatch(
+  const std::vector<std::tuple<std::string, std::string, double, double, double>> &results,
+  bool                                                                             truncate)
+{
+    std::ofstream file(m_dispatchPath, truncate ? std::ios::trunc : std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Cannot open dispatch output file: " << m_dispatchPath << std::endl;
+        return false;
+    }
+
+    if (truncate || file.tellp() == 0) {
+        file << "eqp_id,lot_id,solution_release_time,start_time,end_time\n";
+    }
+    for (const auto &[eqpId, lotId, releaseTime, startTime, endTime]: results) {
+        file << eqpId << ',' << lotId << ',' << releaseTime << ',' << startTime << ',' << endTime << '\n';
+    }
+
+    return file.good();
+}
+
+std::unique_ptr<ScheduleDataManager> ScheduleDataManager::createFromSnapshot(const std::string &snapshotPath)
+{
+    return std::make_unique<SnapshotDataManager>(snapshotPath);
+}
+
+}    // namespace schedule
+}    // namespace rtd
@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# 单机多进程测试分布式岛屿
+# 用法: ./test_distributed.sh [工作进程数] [端口] [调度周期秒数]
+# 协调进程就是普通的rtd_schedule，需要在config/schedule.json中设置distributed.enabled为true
+
+BIN=${BIN:-./rtd_schedule}
+WORKERS=${1:-3}
+PORT=${2:-7600}
+INTERVAL=${3:-60}
+
+pids=()
+cleanup() {
+    kill "${pids[@]}" 2>/dev/null
+    wait "${pids[@]}" 2>/dev/null
+}
+trap cleanup EXIT
+
+echo "启动 $WORKERS 个岛屿工作进程..."
+for i in $(seq 1 "$WORKERS"); do
+    "$BIN" --worker "127.0.0.1:$PORT" > "worker_$i.log" 2>&1 &
+    pids+=($!)
+done
+
+echo "启动协调进程（Ctrl+C退出），工作进程日志: worker_*.log"
+"$BIN" "$INTERVAL"
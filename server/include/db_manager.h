@@ -19,6 +19,9 @@ class DbManager {
         // 获取数据库会话
         std::shared_ptr<soci::session> getSession(const std::string &dataSourceName);
 
+        // 数据源使用的后端名称，用于选择SQL方言；数据源未配置时返回缺省后端
+        std::string backendOf(const std::string &dataSourceName);
+
     private:
         DbManager() = default;
         ~DbManager();
@@ -32,6 +35,7 @@ class DbManager {
 
         // 数据源配置
         struct DataSourceConfig {
+                std::string backend;
                 std::string dsnPath;
                 int         minConn;
                 int         maxConn;
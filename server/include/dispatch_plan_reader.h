@@ -0,0 +1,57 @@
+#pragma once
+
+#include "dispatch_plan_layout.h"
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <shared_mutex>
+#include <string>
+
+using json = nlohmann::json;
+
+/**
+ * 内存派工计划读取器
+ * 只读映射rtd_schedule发布的派工计划快照，按设备回答"下一批次"查询，不访问数据库
+ */
+class DispatchPlanReader {
+    public:
+        static DispatchPlanReader &instance();
+
+        // 初始化内存派工计划路径
+        bool initialize(const std::string &planPath = rtd::dispatch::kDefaultPlanPath);
+
+        // 获取设备的下一个待执行批次
+        json getNextLot(const std::string &eqpId);
+
+        // 获取设备的派工队列，limit为0表示全部
+        json getQueue(const std::string &eqpId, size_t limit = 0);
+
+    private:
+        DispatchPlanReader() = default;
+        ~DispatchPlanReader();
+
+        // 禁用复制构造函数和赋值操作符
+        DispatchPlanReader(const DispatchPlanReader &)            = delete;
+        DispatchPlanReader &operator=(const DispatchPlanReader &) = delete;
+
+        // 映射最新的计划快照（需持有写锁）
+        bool remap();
+
+        // 释放当前映射（需持有写锁）
+        void unmap();
+
+        // 确保映射的是最新快照，返回时持有读锁
+        std::shared_lock<std::shared_mutex> acquire();
+
+        // 查找设备条目（需持有读锁）
+        const rtd::dispatch::PlanEquipment *findEquipment(const std::string &eqpId) const;
+
+        // 将派工条目转换为JSON（需持有读锁）
+        json entryToJson(const rtd::dispatch::PlanEquipment &equipment, const rtd::dispatch::PlanEntry &entry) const;
+
+        std::string                      m_planPath;
+        const char                      *m_base   = nullptr;
+        size_t                           m_size   = 0;
+        const rtd::dispatch::PlanHeader *m_header = nullptr;
+        std::shared_mutex                m_mutex;
+        bool                             m_initialized = false;
+};
@@ -1,5 +1,7 @@
 #include "api_handler.h"
+#include "data_source_backend.h"
 #include "db_manager.h"
+#include <deque>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -38,7 +40,7 @@ bool ApiHandler::initialize(const std::string &apiConfigPath)
             info.id          = query["id"];
             info.dataSource  = query["data_source"];
             info.description = query["description"];
-            info.sql         = query["sql"];
+            info.sql         = rtd::datasource::querySql(query, DbManager::instance().backendOf(info.dataSource));
 
             for (const auto &param: query["params"]) {
                 info.params.push_back(param);
@@ -85,10 +87,10 @@ json ApiHandler::handleRequest(const std::string &queryId, const json &params)
         // 准备SQL语句
         soci::statement stmt = session->prepare << query.sql;
 
-        // 临时保存参数值用于绑定
-        std::string strValue;
-        int         intValue;
-        double      doubleValue;
+        // 保存参数值用于绑定，use()绑定的是引用，每个参数要有各自的存储
+        std::deque<std::string> strValues;
+        std::deque<int>         intValues;
+        std::deque<double>      doubleValues;
 
         // 绑定参数
         for (const auto &paramName: query.params) {
@@ -101,16 +103,16 @@ json ApiHandler::handleRequest(const std::string &queryId, const json &params)
             const auto &paramValue = params[paramName];
 
             if (paramValue.is_string()) {
-                strValue = paramValue.get<std::string>();
-                stmt.exchange(soci::use(strValue));
+                strValues.push_back(paramValue.get<std::string>());
+                stmt.exchange(soci::use(strValues.back()));
             }
             else if (paramValue.is_number_integer()) {
-                intValue = paramValue.get<int>();
-                stmt.exchange(soci::use(intValue));
+                intValues.push_back(paramValue.get<int>());
+                stmt.exchange(soci::use(intValues.back()));
             }
             else if (paramValue.is_number_float()) {
-                doubleValue = paramValue.get<double>();
-                stmt.exchange(soci::use(doubleValue));
+                doubleValues.push_back(paramValue.get<double>());
+                stmt.exchange(soci::use(doubleValues.back()));
             }
             else {
                 return {
@@ -1,7 +1,7 @@
 #include "db_manager.h"
+#include "data_source_backend.h"
 #include <fstream>
 #include <iostream>
-#include <soci/odbc/soci-odbc.h>
 
 DbManager &DbManager::instance()
 {
@@ -31,11 +31,18 @@ bool DbManager::initialize(const std::string &configPath)
         // 解析每个数据源的配置
         for (auto &[name, source]: config.items()) {
             DataSourceConfig sourceConfig;
+            sourceConfig.backend     = source.value("backend", rtd::datasource::kDefaultBackend);
             sourceConfig.dsnPath     = source["dsn_path"];
             sourceConfig.minConn     = source["min_conn"];
             sourceConfig.maxConn     = source["max_conn"];
             sourceConfig.connTimeout = source["conn_timeout"];
 
+            const soci::backend_factory *backend = rtd::datasource::backendFactory(sourceConfig.backend);
+            if (!backend) {
+                std::cerr << "不支持的数据源后端: " << name << " " << sourceConfig.backend << std::endl;
+                continue;
+            }
+
             // 加载DSN文件内容
             sourceConfig.connectionString = loadDsn(sourceConfig.dsnPath);
             if (sourceConfig.connectionString.empty()) {
@@ -49,7 +56,7 @@ bool DbManager::initialize(const std::string &configPath)
             std::vector<std::shared_ptr<soci::session>> pool;
             for (int i = 0; i < sourceConfig.minConn; i++) {
                 try {
-                    auto session = std::make_shared<soci::session>(soci::odbc, sourceConfig.connectionString);
+                    auto session = std::make_shared<soci::session>(*backend, sourceConfig.connectionString);
                     pool.push_back(session);
                 }
                 catch (const std::exception &e) {
@@ -96,7 +103,7 @@ std::shared_ptr<soci::session> DbManager::getSession(const std::string &dataSour
 
     // 如果池已满，则创建一个新的连接但不添加到池中
     try {
-        return std::make_shared<soci::session>(soci::odbc, config.connectionString);
+        return std::make_shared<soci::session>(*rtd::datasource::backendFactory(config.backend), config.connectionString);
     }
     catch (const std::exception &e) {
         std::cerr << "创建数据库连接失败: " << e.what() << std::endl;
@@ -104,6 +111,14 @@ std::shared_ptr<soci::session> DbManager::getSession(const std::string &dataSour
     }
 }
 
+std::string DbManager::backendOf(const std::string &dataSourceName)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_configs.find(dataSourceName);
+    return it == m_configs.end() ? rtd::datasource::kDefaultBackend : it->second.backend;
+}
+
 std::string DbManager::loadDsn(const std::string &dsnPath)
 {
     std::ifstream file(dsnPath);
@@ -0,0 +1,243 @@
+#include "dispatch_plan_reader.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace rtd::dispatch;
+
+namespace {
+
+// [offset, offset + count * elementSize)是否在size以内，乘法和加法溢出时返回false
+bool arrayFits(uint64_t offset, uint64_t count, size_t elementSize, size_t size)
+{
+    return offset <= size && count <= (size - offset) / elementSize;
+}
+
+/**
+ * 检查设备表和条目表都在文件内、按类型对齐，且每台设备的条目区间都在条目表内，
+ * ID都以'\0'结尾，通过后读取时不再逐项检查
+ */
+bool validPlan(const char *base, size_t size)
+{
+    const auto *header = reinterpret_cast<const PlanHeader *>(base);
+    if (!arrayFits(header->equipmentOffset, header->equipmentCount, sizeof(PlanEquipment), size) || !arrayFits(header->entryOffset, header->entryCount, sizeof(PlanEntry), size) || header->equipmentOffset % alignof(PlanEquipment) != 0 || header->entryOffset % alignof(PlanEntry) != 0) {
+        return false;
+    }
+
+    const auto *equipments = reinterpret_cast<const PlanEquipment *>(base + header->equipmentOffset);
+    for (uint64_t i = 0; i < header->equipmentCount; ++i) {
+        const PlanEquipment &equipment = equipments[i];
+        if (equipment.eqpId[kPlanIdLength - 1] != '\0' || equipment.firstEntry > header->entryCount || equipment.entryCount > header->entryCount - equipment.firstEntry) {
+            return false;
+        }
+    }
+
+    const auto *entries = reinterpret_cast<const PlanEntry *>(base + header->entryOffset);
+    for (uint64_t i = 0; i < header->entryCount; ++i) {
+        if (entries[i].lotId[kPlanIdLength - 1] != '\0') {
+            return false;
+        }
+    }
+    return true;
+}
+
+}    // namespace
+
+DispatchPlanReader &DispatchPlanReader::instance()
+{
+    static DispatchPlanReader instance;
+    return instance;
+}
+
+bool DispatchPlanReader::initialize(const std::string &planPath)
+{
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+    m_planPath    = planPath;
+    m_initialized = true;
+
+    // 调度引擎可能尚未发布计划，此时不视为错误，查询时再重试映射
+    if (!remap()) {
+        std::cout << "内存派工计划尚未发布: " << m_planPath << std::endl;
+    }
+
+    return true;
+}
+
+DispatchPlanReader::~DispatchPlanReader()
+{
+    unmap();
+}
+
+bool DispatchPlanReader::remap()
+{
+    unmap();
+
+    int fd = ::open(m_planPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(PlanHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void *base = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        std::cerr << "映射内存派工计划失败: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    const auto *header = static_cast<const PlanHeader *>(base);
+    if (header->magic != kPlanMagic || header->version != kPlanVersion || !validPlan(static_cast<const char *>(base), st.st_size)) {
+        std::cerr << "内存派工计划格式无效: " << m_planPath << std::endl;
+        ::munmap(base, st.st_size);
+        return false;
+    }
+
+    m_base   = static_cast<const char *>(base);
+    m_size   = st.st_size;
+    m_header = header;
+    return true;
+}
+
+void DispatchPlanReader::unmap()
+{
+    if (m_base) {
+        ::munmap(const_cast<char *>(m_base), m_size);
+    }
+
+    m_base   = nullptr;
+    m_size   = 0;
+    m_header = nullptr;
+}
+
+std::shared_lock<std::shared_mutex> DispatchPlanReader::acquire()
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        if (m_header && m_header->superseded.load(std::memory_order_acquire) == 0) {
+            return lock;
+        }
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        if (!m_header || m_header->superseded.load(std::memory_order_acquire) != 0) {
+            remap();
+        }
+    }
+
+    return std::shared_lock<std::shared_mutex>(m_mutex);
+}
+
+const PlanEquipment *DispatchPlanReader::findEquipment(const std::string &eqpId) const
+{
+    const auto *begin = reinterpret_cast<const PlanEquipment *>(m_base + m_header->equipmentOffset);
+    const auto *end   = begin + m_header->equipmentCount;
+
+    // 与写入方一致地截断ID
+    std::string key = eqpId.substr(0, kPlanIdLength - 1);
+
+    const auto *it = std::lower_bound(begin, end, key, [](const PlanEquipment &equipment, const std::string &id) {
+        return std::strcmp(equipment.eqpId, id.c_str()) < 0;
+    });
+
+    if (it == end || key != it->eqpId) {
+        return nullptr;
+    }
+
+    return it;
+}
+
+json DispatchPlanReader::entryToJson(const PlanEquipment &equipment, const PlanEntry &entry) const
+{
+    return {
+      {"eqp_id",                equipment.eqpId       },
+      {"lot_id",                entry.lotId           },
+      {"processing_time",       entry.processingTime  },
+      {"start_time",            entry.startTime       },
+      {"end_time",              entry.endTime         },
+      {"solution_release_time", m_header->releaseTime },
+      {"plan_sequence",         m_header->sequence    }
+    };
+}
+
+json DispatchPlanReader::getNextLot(const std::string &eqpId)
+{
+    if (!m_initialized) {
+        return {
+          {"error", "派工计划读取器未初始化"}
+        };
+    }
+
+    auto lock = acquire();
+    if (!m_header) {
+        return {
+          {"error", "内存派工计划不可用"}
+        };
+    }
+
+    const PlanEquipment *equipment = findEquipment(eqpId);
+    if (!equipment) {
+        return {
+          {"error", "派工计划中没有设备: " + eqpId}
+        };
+    }
+
+    if (equipment->entryCount == 0) {
+        return {
+          {"data", nullptr}
+        };
+    }
+
+    const auto *entries = reinterpret_cast<const PlanEntry *>(m_base + m_header->entryOffset);
+    return {
+      {"data", entryToJson(*equipment, entries[equipment->firstEntry])}
+    };
+}
+
+json DispatchPlanReader::getQueue(const std::string &eqpId, size_t limit)
+{
+    if (!m_initialized) {
+        return {
+          {"error", "派工计划读取器未初始化"}
+        };
+    }
+
+    auto lock = acquire();
+    if (!m_header) {
+        return {
+          {"error", "内存派工计划不可用"}
+        };
+    }
+
+    const PlanEquipment *equipment = findEquipment(eqpId);
+    if (!equipment) {
+        return {
+          {"error", "派工计划中没有设备: " + eqpId}
+        };
+    }
+
+    const auto *entries = reinterpret_cast<const PlanEntry *>(m_base + m_header->entryOffset);
+    size_t      count   = equipment->entryCount;
+    if (limit > 0) {
+        count = std::min<size_t>(count, limit);
+    }
+
+    json result = json::array();
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(entryToJson(*equipment, entries[equipment->firstEntry + i]));
+    }
+
+    return {
+      {"data", result}
+    };
+}
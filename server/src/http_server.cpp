@@ -1,5 +1,6 @@
 #include "http_server.h"
 #include "api_handler.h"
+#include "dispatch_plan_reader.h"
 #include <iostream>
 
 HttpServer::HttpServer(int port)
@@ -33,6 +34,33 @@ void HttpServer::setupRoutes()
         return handleApiRequest(req, queryId);
     });
 
+    // 内存派工计划：设备的下一个批次
+    CROW_ROUTE(m_app, "/dispatch/<string>/next")
+    ([](std::string eqpId) {
+        crow::response res(200, DispatchPlanReader::instance().getNextLot(eqpId).dump());
+        res.set_header("Content-Type", "application/json");
+        return res;
+    });
+
+    // 内存派工计划：设备的派工队列，可用?limit=N限制条数
+    CROW_ROUTE(m_app, "/dispatch/<string>/queue")
+    ([](const crow::request &req, std::string eqpId) {
+        size_t      limit      = 0;
+        const char *limitParam = req.url_params.get("limit");
+        if (limitParam) {
+            try {
+                limit = std::stoul(limitParam);
+            }
+            catch (const std::exception &) {
+                return crow::response(400, "{\"error\":\"limit参数无效\"}");
+            }
+        }
+
+        crow::response res(200, DispatchPlanReader::instance().getQueue(eqpId, limit).dump());
+        res.set_header("Content-Type", "application/json");
+        return res;
+    });
+
     // 处理404
     CROW_CATCHALL_ROUTE(m_app)
     ([](crow::response &res) {
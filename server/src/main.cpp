@@ -1,5 +1,6 @@
 #include "api_handler.h"
 #include "db_manager.h"
+#include "dispatch_plan_reader.h"
 #include "http_server.h"
 #include <csignal>
 #include <iostream>
@@ -41,6 +42,13 @@ int main(int argc, char *argv[])
             port = std::stoi(argv[1]);
         }
 
+        // 初始化内存派工计划读取器，第二个参数可指定计划文件路径
+        std::string planPath = rtd::dispatch::kDefaultPlanPath;
+        if (argc > 2) {
+            planPath = argv[2];
+        }
+        DispatchPlanReader::instance().initialize(planPath);
+
         g_server = std::make_unique<HttpServer>(port);
         g_server->start();
 
@@ -35,3 +35,9 @@ echo -e "\n\n测试根据设备ID查询调度记录..."
 curl -s -X POST $HOST/api/searchDispatchByEqpId \
   -H "Content-Type: application/json" \
   -d '{"eqp_id": "EQP001"}' | jq
+
+echo -e "\n\n测试内存派工计划：设备下一批次..."
+curl -s $HOST/dispatch/EQP001/next | jq
+
+echo -e "\n\n测试内存派工计划：设备派工队列..."
+curl -s "$HOST/dispatch/EQP001/queue?limit=5" | jq